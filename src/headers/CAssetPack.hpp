@@ -0,0 +1,149 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Exceptions.hpp"
+#include "EAssetKind.hpp"
+
+/**
+ * @brief A single file with the assets already decoded, mapped into memory
+ * 
+ * The images are stored as RGBA32 pixels, the glyph atlases of the texts together with
+ * the part of the atlas with each character. An index at the start of the file finds them.
+ * The pixels are used straight from the mapping, so loading the pack costs only
+ * the pages that are read, no image gets decoded. The header keeps a fingerprint
+ * of the source files, so a pack older than the assets can be told apart
+ */
+class CAssetPack
+{
+public:
+    /**
+     * @brief An asset to be written into a pack
+     */
+    struct SAsset
+    {
+        EAssetKind kind;                /**< The kind of the asset */
+        int id;                         /**< The label of the asset within its kind */
+        SDL_Surface * image;            /**< The image, converted to RGBA32 when written */
+        std::vector<SDL_FRect> glyphs;  /**< The parts of a glyph atlas with the characters, empty for other images */
+    };
+
+    /**
+     * @brief Maps the pack into memory
+     * 
+     * @param filePath the path to the pack
+     * @warning Throws FileException if the pack doesn't exist, can't be mapped or is damaged
+     */
+    CAssetPack(const std::string & filePath);
+
+    CAssetPack(const CAssetPack & orig) = delete;
+    CAssetPack & operator = (const CAssetPack & orig) = delete;
+
+    /**
+     * @brief Unmaps the pack, the images returned by image() must not be used anymore
+     */
+    ~CAssetPack();
+
+    /**
+     * @brief Returns an image stored in the pack
+     * 
+     * The surface only points into the mapping, it doesn't copy the pixels
+     * 
+     * @param kind the kind of the asset
+     * @param id the label of the asset
+     * @return the image, which the caller frees
+     * @warning Throws FileException if the pack doesn't contain the asset
+     */
+    SDL_Surface * image(const EAssetKind & kind, const int & id) const;
+
+    /**
+     * @brief Returns the parts of a glyph atlas with the characters
+     * 
+     * @param kind the kind of the asset
+     * @param id the label of the asset
+     * @return the glyphs
+     * @warning Throws FileException if the pack doesn't contain the asset
+     */
+    std::vector<SDL_FRect> glyphs(const EAssetKind & kind, const int & id) const;
+
+    /**
+     * @brief Returns the fingerprint of the source files the pack was built from
+     * 
+     * @return the fingerprint, see fingerprint()
+     */
+    uint64_t getSources() const;
+
+    /**
+     * @brief Writes the assets into a pack
+     * 
+     * @param filePath the path to the pack
+     * @param assets the assets
+     * @param sources the fingerprint of the files the assets were decoded from
+     * @warning Throws FileException if the pack could not be written
+     */
+    static void write(const std::string & filePath, const std::vector<SAsset> & assets, const uint64_t & sources);
+
+    /**
+     * @brief Returns a fingerprint of files, which changes whenever any of them changes its size or modification time
+     * 
+     * A missing file counts as an empty one, which was never modified
+     * 
+     * @param filePaths the paths to the files
+     * @return the fingerprint
+     */
+    static uint64_t fingerprint(const std::vector<std::string> & filePaths);
+
+private:
+    /**
+     * @brief The start of the pack
+     */
+    struct SHeader
+    {
+        char magic[4];      /**< Identifies the file as a pack */
+        uint32_t version;   /**< The version of the format */
+        uint32_t count;     /**< The number of entries in the index */
+        uint32_t padding;   /**< Keeps the index aligned */
+        uint64_t sources;   /**< The fingerprint of the source files */
+    };
+
+    /**
+     * @brief An entry of the index, the offsets are counted from the start of the pack
+     */
+    struct SEntry
+    {
+        uint32_t kind;          /**< The kind of the asset */
+        uint32_t id;            /**< The label of the asset */
+        uint32_t width;         /**< The width of the image */
+        uint32_t height;        /**< The height of the image */
+        uint64_t pixels;        /**< Where the RGBA32 pixels start, the rows aren't padded */
+        uint64_t glyphs;        /**< Where the glyphs start */
+        uint32_t glyphCount;    /**< The number of the glyphs */
+        uint32_t padding;       /**< Keeps the entries aligned */
+    };
+
+    static constexpr char magic[4] = {'N', 'P', 'A', 'K'};
+    static constexpr uint32_t version = 2;
+    static constexpr uint64_t alignment = 16;
+
+    const uint8_t * data;   /**< The mapped pack */
+    size_t size;            /**< The size of the pack in bytes */
+
+    /**
+     * @brief Finds an asset in the index
+     * 
+     * @param kind the kind of the asset
+     * @param id the label of the asset
+     * @return the entry of the asset
+     * @warning Throws FileException if the pack doesn't contain the asset
+     */
+    const SEntry & find(const EAssetKind & kind, const int & id) const;
+};
\ No newline at end of file
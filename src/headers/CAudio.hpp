@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <cmath>
+#include <random>
+
+#include "EEvent.hpp"
+
+/**
+ * @brief Plays the sounds of the game events
+ * 
+ * The sounds are synthesised once, when the audio opens, so playing one never touches the disk.
+ * Every sound has a channel of its own, so the channels never run out and a sound
+ * started again only replaces itself. Starting a sound doesn't wait for the audio,
+ * SDL_mixer only takes the audio lock for the moment it takes to swap the chunk
+ */
+class CAudio
+{
+public:
+    /**
+     * @brief Opens the audio device and prepares the sounds
+     * 
+     * @warning Throws an error if the audio could not be opened, the game can go on without it
+     */
+    CAudio();
+
+    CAudio(const CAudio & orig) = delete;
+    CAudio & operator = (const CAudio & orig) = delete;
+
+    /**
+     * @brief Stops the sounds and closes the audio device
+     */
+    ~CAudio();
+
+    /**
+     * @brief Plays the sounds of the events
+     * 
+     * Each sound plays once however many events of its type happened. A sound started
+     * shortly before keeps playing, so an explosion lasting several frames sounds as one
+     * 
+     * @param events a bit (1 << event type) for each type of event that happened
+     */
+    void play(const uint32_t & events);
+
+private:
+    /**
+     * @brief A sound with its own channel
+     */
+    struct SSound
+    {
+        EEvent event;                   /**< The event the sound belongs to */
+        std::vector<int16_t> samples;   /**< The synthesised samples, the chunk plays them without copying */
+        Mix_Chunk * chunk;              /**< The chunk of the mixer */
+        Uint32 started;                 /**< When the sound was started the last time, in milliseconds */
+    };
+
+    /**
+     * @brief How a sound gets synthesised - a tone sliding from one pitch to another, mixed with noise
+     */
+    struct STone
+    {
+        EEvent event;       /**< The event the sound belongs to */
+        double from;        /**< The starting frequency in Hz */
+        double to;          /**< The ending frequency in Hz */
+        double duration;    /**< The length in seconds */
+        double noise;       /**< The share of the noise, from 0 to 1 */
+        double volume;      /**< The loudness, from 0 to 1 */
+    };
+
+    std::vector<SSound> sounds;     /**< The sounds, the index of a sound is its channel */
+
+    // Samples per audio buffer, kept short for a low latency (about 12 ms at 44.1 kHz)
+    static constexpr int bufferSamples = 512;
+
+    // The least time between two starts of one sound
+    static constexpr Uint32 restartDelay = 50;
+
+    /**
+     * @brief Frees the sounds and closes the audio device
+     */
+    void close();
+
+    /**
+     * @brief Synthesises a sound in the format of the opened device
+     * 
+     * @param tone the description of the sound
+     * @param frequency the samples per second of the device
+     * @param channels the number of the output channels of the device
+     * @return the samples
+     */
+    static std::vector<int16_t> synthesise(const STone & tone, const int & frequency, const int & channels);
+};
\ No newline at end of file
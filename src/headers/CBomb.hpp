@@ -5,7 +5,7 @@
 /**
  * @brief Takes care of bomb instances
  */
-class CBomb : public CObject
+class CBomb final : public CObject
 {
 public:
     /**
@@ -25,12 +25,12 @@ public:
      * 
      * After a certain amount of time frames, explode
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void update(Events & events, const TileSet & tileSet,
-                const std::list<std::shared_ptr<CObject>> & objects) override;
+    void update(CEventQueue & events, const CTileGrid & tileSet,
+                const CSpatialGrid & grid);
 
     /**
      * @brief Create events
@@ -41,11 +41,39 @@ public:
      * The explosion looks like a cross on the map, it cannot go through the undestroyable walls
      * and its size is determined by the boomSize variable
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects) override;
+    void createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid);
+
+    /**
+     * @brief Renders the bomb, unless it is hidden in this time frame
+     * 
+     * @param alpha how far the rendered frame is between the last and the next time frame (0 to 1)
+     */
+    void render(const double & alpha = 1) const override;
+
+    /**
+     * @brief Returns the size of the explosion
+     * 
+     * @return the number of tiles the explosion reaches in each direction
+     */
+    int getSize() const;
+
+    /**
+     * @brief Writes the state of the bomb into a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void save(CSnapshot & snapshot) const override;
+
+    /**
+     * @brief Reads the state of the bomb from a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void load(CSnapshot & snapshot) override;
 
 private:
     bool hasExploded;   /**< Specifies, whether the bomb has exploded */
@@ -1,15 +1,15 @@
 #pragma once
 
-#include <map>
-
 #include "CObject.hpp"
 #include "Utilities.hpp"
+#include "CRandom.hpp"
+#include "CConfig.hpp"
 #include "EBonusType.hpp"
 
 /**
  * @brief Takes care of bonus instances
  */
-class CBonus : public CObject
+class CBonus final : public CObject
 {
 public:
     /**
@@ -18,35 +18,37 @@ public:
      * @param position the position on the screen window
      * @param tile the tile type in map
      * @param texture the sprite to render
+     * @param random the random number generator of the game - decides the type of the bonus
+     * @param config the configuration of the game - holds the strength of the bonuses
      */
     CBonus(const std::pair<int, int> & position, const ETileType & tile,
-           const std::shared_ptr<CRenderWindow::CTexture> & texture);
+           const std::shared_ptr<CRenderWindow::CTexture> & texture, CRandom & random, const CConfig & config);
 
     /**
      * @brief Updates the object according to events
      * 
      * When in collision with a player, create events
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void update(Events & events,
-                const TileSet & tileSet,
-                const std::list<std::shared_ptr<CObject>> & objects) override;
+    void update(CEventQueue & events,
+                const CTileGrid & tileSet,
+                const CSpatialGrid & grid);
 
     /**
      * @brief Create events
      * 
      * The bonus flags itself to be removed and creates an event GET_BONUS,
-     * which carries the type of the bonus, its strenght and a reference
-     * to the player who picked it up.
+     * which carries the type of the bonus, its strenght and the tile type
+     * of the player who picked it up.
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects) override;
+    void createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid);
 
     /**
      * @brief Retuns the position on the tile map
@@ -58,13 +60,14 @@ public:
     std::pair<int,int> getTilePos() const override;
 
 private:
-    inline static std::map<EBonusType, int> bonuses;     /**< A map of all the existing events */
+    CRandom * random;                                   /**< The random number generator of the game */
+    const CConfig * config;                             /**< The configuration of the game */
 
     // Scaling constants for the collision box
-    const double xBox = 0.25;
-    const double yBox = 0.25;
-    const double wBox = 0.5;
-    const double hBox = 0.5;
+    static constexpr double xBox = 0.25;
+    static constexpr double yBox = 0.25;
+    static constexpr double wBox = 0.5;
+    static constexpr double hBox = 0.5;
 
     /**
      * @brief Specifies the collision box of the bonus
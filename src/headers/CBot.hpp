@@ -0,0 +1,160 @@
+#pragma once
+
+#include <vector>
+#include <climits>
+
+#include "CObjectEventManager.hpp"
+#include "CRandom.hpp"
+#include "EInput.hpp"
+
+/**
+ * @brief A computer player, which decides the input of one player from the state of the game
+ * 
+ * Every time frame it looks at the map as a grid of tiles: it runs away from the tiles
+ * the bombs will reach, places a bomb when it would destroy a breakable or hit an enemy
+ * or the other player and there is a way out, and otherwise walks towards the nearest
+ * such place (or to the door, once there is one). The bot only reads the game,
+ * so the game stays deterministic - the same seeds give the same matches
+ */
+class CBot
+{
+public:
+    /**
+     * @brief CBot constructor
+     * 
+     * @param player the player controlled by the bot - PLAYER1 or PLAYER2
+     * @param seed the seed of the bot's own random numbers, 0 means a random one
+     */
+    CBot(const ETileType & player, const uint64_t & seed = 0);
+
+    /**
+     * @brief Decides the input of the player in the next time frame
+     * 
+     * @param manager the game
+     * @return a combination of EInput bits
+     */
+    uint8_t think(const CObjectEventManager & manager);
+
+private:
+    ETileType player;                   /**< The player controlled by the bot */
+    CRandom random;                     /**< Decides where to go, when the bot gets stuck */
+    bool pressedBomb;                   /**< The bomb key was pressed in the last time frame, it must be released first */
+    std::pair<int,int> lastPosition;    /**< The position of the player in the last time frame */
+    int stuckFrames;                    /**< The number of time frames the player didn't move, although it wanted to */
+    uint8_t wander;                     /**< The direction held while getting unstuck */
+    int wanderFrames;                   /**< The number of time frames left to hold the direction */
+    int width;                          /**< The width of the map in tiles */
+    std::vector<uint8_t> danger;        /**< The tiles which an explosion is going to reach or where an enemy stands */
+    std::vector<uint8_t> planned;       /**< The danger including a bomb the bot considers placing */
+    std::vector<uint8_t> targets;       /**< The tiles with a breakable, an enemy or the other player */
+    std::vector<int> parent;            /**< The tile from which the search came to each tile */
+    std::vector<int> queue;             /**< The tiles waiting to be searched */
+
+    // The kinds of danger on a tile
+    static constexpr uint8_t blast = 1;
+    static constexpr uint8_t enemy = 2;
+
+    /**
+     * @brief Finds the dangerous tiles and the targets on the map
+     * 
+     * @param manager the game
+     */
+    void look(const CObjectEventManager & manager);
+
+    /**
+     * @brief Marks the tiles an explosion reaches, the same way CBomb places the explosion
+     * 
+     * @param tiles the tiles of the map
+     * @param grid where to mark the tiles
+     * @param x x position of the bomb
+     * @param y y position of the bomb
+     * @param size the size of the explosion
+     */
+    void markBlast(const CTileGrid & tiles, std::vector<uint8_t> & grid, const int & x, const int & y, const int & size) const;
+
+    /**
+     * @brief Checks, whether a bomb placed on a tile would hit a target
+     * 
+     * @param tiles the tiles of the map
+     * @param cell the tile
+     * @param size the size of the explosion
+     * @return true - it would destroy a breakable or hit an enemy or the other player
+     * @return false - otherwise
+     */
+    bool worthBombing(const CTileGrid & tiles, const int & cell, const int & size);
+
+    /**
+     * @brief Searches the map for the nearest tile satisfying a condition
+     * 
+     * Walls, breakables and enemies can't be walked through
+     * 
+     * @param tiles the tiles of the map
+     * @param from the tile the search starts from
+     * @param avoid tiles with a blast in this grid can't be walked through, nullptr walks through them
+     * @param maxSteps the maximal number of tiles to walk
+     * @param isTarget the condition
+     * @return the first tile to walk to, from itself when it satisfies the condition, -1 when there is no such tile
+     */
+    template <typename F>
+    int search(const CTileGrid & tiles, const int & from, const std::vector<uint8_t> * avoid, const int & maxSteps, F && isTarget);
+
+    /**
+     * @brief Decides which way to move, so the player gets onto a tile
+     * 
+     * The player first lines up with the tile, so it doesn't get caught on the corners of the walls
+     * 
+     * @param me the player
+     * @param from the tile the player stands on
+     * @param to the tile to get onto
+     * @return the direction as EInput bits
+     */
+    uint8_t steer(const CPlayer & me, const int & from, const int & to) const;
+};
+
+template <typename F>
+int CBot::search(const CTileGrid & tiles, const int & from, const std::vector<uint8_t> * avoid, const int & maxSteps, F && isTarget)
+{
+    if (isTarget(from))
+        return from;
+
+    int height = tiles.getHeight();
+    this->parent.assign(this->width * height, -1);
+    this->queue.clear();
+    this->queue.push_back(from);
+    this->parent[from] = from;
+
+    // The queue is walked one layer of steps at a time
+    for (size_t begin = 0, steps = 0; begin < this->queue.size() && (int)steps < maxSteps; ++ steps)
+    {
+        size_t end = this->queue.size();
+        for (; begin < end; ++ begin)
+        {
+            int cell = this->queue[begin];
+            int x = cell % this->width;
+            int y = cell / this->width;
+
+            for (auto [nx, ny] : {std::make_pair(x, y - 1), std::make_pair(x, y + 1), std::make_pair(x - 1, y), std::make_pair(x + 1, y)})
+            {
+                if (nx < 0 || ny < 0 || nx >= this->width || ny >= height)
+                    continue;
+
+                int next = ny * this->width + nx;
+                if (this->parent[next] != -1 || tiles.isSolid(nx, ny) || (this->danger[next] & enemy)
+                 || (avoid && ((*avoid)[next] & blast)))
+                    continue;
+
+                this->parent[next] = cell;
+                if (isTarget(next))
+                {
+                    // Walk back to the first step
+                    while (this->parent[next] != from)
+                        next = this->parent[next];
+                    return next;
+                }
+                this->queue.push_back(next);
+            }
+        }
+    }
+
+    return -1;
+}
\ No newline at end of file
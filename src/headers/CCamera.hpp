@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "GameConstants.hpp"
+
+/**
+ * @brief Decides which part of the map is shown in which part of the window
+ * 
+ * One player gets the whole window. Two players share it as long as they both fit in,
+ * otherwise the window is split in halves, each following one of them.
+ * Only what is inside of a view needs to be drawn, so the cost of rendering
+ * depends on the size of the window, not on the size of the map
+ */
+class CCamera
+{
+public:
+    /**
+     * @brief One part of the window showing one part of the map
+     */
+    struct SView
+    {
+        SDL_Rect world;     /**< The part of the map shown, in map pixels */
+        SDL_Rect screen;    /**< Where it is shown in the window, of the same size */
+    };
+
+    /**
+     * @brief CCamera constructor
+     * 
+     * @param width the width of the window
+     * @param height the height of the window
+     */
+    CCamera(const int & width = screenWidth, const int & height = screenHeight);
+
+    /**
+     * @brief Moves the views onto the followed points
+     * 
+     * The views don't leave the map, a map smaller than the window is shown in its middle.
+     * Without any points to follow, the views stay where they were
+     * 
+     * @param targets the followed points in map pixels, one for each player
+     * @param mapWidth the width of the map in pixels
+     * @param mapHeight the height of the map in pixels
+     */
+    void follow(const std::vector<std::pair<int,int>> & targets, const int & mapWidth, const int & mapHeight);
+
+    /**
+     * @brief Returns the views to draw
+     * 
+     * @return the views
+     */
+    const std::vector<SView> & getViews() const;
+
+private:
+    int width;                  /**< The width of the window */
+    int height;                 /**< The height of the window */
+    std::vector<SView> views;   /**< The current views */
+
+    /**
+     * @brief Centers a view on a point, keeping it inside of the map
+     * 
+     * @param target the point in map pixels
+     * @param screen the part of the window with the view
+     * @param mapWidth the width of the map in pixels
+     * @param mapHeight the height of the map in pixels
+     * @return the view
+     */
+    static SView centre(const std::pair<int,int> & target, const SDL_Rect & screen, const int & mapWidth, const int & mapHeight);
+};
\ No newline at end of file
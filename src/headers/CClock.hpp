@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <functional>
+
+#include "GameConstants.hpp"
+
+/**
+ * @brief A fixed time step clock for the game loop
+ * 
+ * Accumulates the real time passed between rendered frames and splits it into
+ * fixed time frames (ticks) of the game logic. That way the game runs at the same
+ * speed no matter how fast or slow the display is
+ */
+class CClock
+{
+public:
+    /**
+     * @brief CClock constructor
+     * 
+     * @param tickDelay the length of one time frame in milliseconds
+     * @param maxFrameSkip the maximum of rendered frames skipped in a row
+     * @param now the source of the real time in milliseconds, replaced only by the tests
+     */
+    CClock(const double & tickDelay = ::tickDelay, const int & maxFrameSkip = ::maxFrameSkip,
+           std::function<double()> now = realTime);
+
+    /**
+     * @brief Adds the real time passed since the last frame into the accumulator
+     * 
+     * When the game falls behind too much, the excess time is dropped,
+     * so the game slows down instead of never catching up
+     */
+    void startFrame();
+
+    /**
+     * @brief Tells whether the game logic should advance by one time frame
+     * 
+     * Consumes one time frame from the accumulator
+     * 
+     * @return true - a time frame should be simulated
+     * @return false - the game logic caught up with the real time
+     */
+    bool tick();
+
+    /**
+     * @brief Tells whether the current frame should be rendered
+     * 
+     * The frame gets skipped, when simulating the time frames of this frame took longer
+     * than the real time they stand for, so the game logic falls behind. The time saved
+     * on rendering goes to the next time frames. Only a limited number of frames
+     * can be skipped in a row
+     * 
+     * @return true - render the frame
+     * @return false - skip it
+     */
+    bool shouldRender();
+
+    /**
+     * @brief Returns how far the real time is between the last and the next time frame
+     * 
+     * Used to interpolate the positions of the objects while rendering
+     * 
+     * @return a number from 0 to 1
+     */
+    double alpha() const;
+
+    /**
+     * @brief Returns the real time at the end of the last simulated time frame
+     * 
+     * The input which happened until then belongs to the time frame
+     * 
+     * @return the time in SDL ticks
+     */
+    Uint32 simulatedUntil() const;
+
+    /**
+     * @brief Reads the real time from the performance counter
+     * 
+     * @return the time in milliseconds
+     */
+    static double realTime();
+
+    /**
+     * @brief Throws away the accumulated time
+     * 
+     * Needed when the game is not running, so it doesn't try to catch up afterwards
+     */
+    void reset();
+
+private:
+    double tickDelay;               /**< The length of one time frame in milliseconds */
+    int maxFrameSkip;               /**< The maximum of rendered frames skipped in a row */
+    double accumulator;             /**< The real time which hasn't been simulated yet in milliseconds */
+    std::function<double()> now;    /**< The source of the real time in milliseconds */
+    double lastFrame;               /**< The real time at the start of the last frame */
+    Uint32 frameTicks;              /**< The SDL ticks at the start of the last frame */
+    int ticks;                      /**< The number of time frames simulated in the current frame */
+    int skippedFrames;              /**< The number of rendered frames skipped in a row */
+};
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <string>
+#include <array>
+#include <map>
+#include <fstream>
+#include <stdexcept>
+#include <climits>
+
+#include "EConfigKey.hpp"
+#include "Exceptions.hpp"
+#include "Utilities.hpp"
+#include "GameConstants.hpp"
+#include "CSnapshot.hpp"
+
+/**
+ * @brief The configuration of the game, read from the configuration file once
+ * 
+ * The file is parsed and checked against the schema of the items when the game starts,
+ * the items are then looked up by their key in memory
+ */
+class CConfig
+{
+public:
+    /**
+     * @brief Loads the configuration file and checks the values
+     * 
+     * @param filePath the path to the configuration file
+     * @warning Throws FileException when an item is missing or can't be read
+     * and invalid_argument when its value is out of range
+     */
+    CConfig(const char * filePath = config);
+
+    /**
+     * @brief Returns a numerical item
+     * 
+     * @param key the item
+     * @return the value
+     */
+    int get(const EConfigKey & key) const;
+
+    /**
+     * @brief Returns a text item
+     * 
+     * @param key the item
+     * @return the text
+     */
+    const std::string & getText(const EConfigKey & key) const;
+
+    /**
+     * @brief Changes a numerical item and saves it into the configuration file
+     * 
+     * @param key the item
+     * @param value the new value
+     */
+    void set(const EConfigKey & key, const int & value);
+
+    /**
+     * @brief Writes all of the numerical items into a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void save(CSnapshot & snapshot) const;
+
+    /**
+     * @brief Replaces the numerical items with the ones read from a snapshot
+     * 
+     * Only the items in memory change, the configuration file stays as it is
+     * 
+     * @param snapshot the snapshot
+     * @warning Throws an invalid_argument when a value is out of range
+     */
+    void load(CSnapshot & snapshot);
+
+private:
+    /**
+     * @brief The description of an item in the configuration file
+     */
+    struct SItem
+    {
+        const char * label;     /**< The label of the item in the file */
+        bool isText;            /**< The item is a text, not a number */
+        int min;                /**< The minimal value */
+        int max;                /**< The maximal value */
+        const char * error;     /**< The error message for a value out of range */
+    };
+
+    static const std::array<SItem, EConfigKey_MAX + 1> schema;  /**< The items of the configuration file */
+
+    std::string filePath;                                       /**< The path to the configuration file */
+    std::array<int, EConfigKey_MAX + 1> values;                 /**< The numerical items */
+    std::array<std::string, EConfigKey_MAX + 1> texts;          /**< The text items */
+
+    /**
+     * @brief Checks, whether the map can be framed by walls and pillars
+     * 
+     * @warning Throws an invalid_argument when the width or the height is even
+     */
+    void checkMapSize() const;
+
+    /**
+     * @brief Reads all of the labels and the data under them from a file
+     * 
+     * @param filePath the path to the file
+     * @return the data under the lower case labels
+     */
+    static std::map<std::string, std::string> parse(const char * filePath);
+};
\ No newline at end of file
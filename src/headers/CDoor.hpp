@@ -5,7 +5,7 @@
 /**
  * @brief Takes care of a door instance
  */
-class CDoor : public CObject
+class CDoor final : public CObject
 {
 public:
     /**
@@ -21,14 +21,14 @@ public:
     /**
      * @brief Updates the door according to events
      * 
-     * Only renders itself and creates events
+     * Only creates events
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void update(Events & events, const TileSet & tileSet,
-                const std::list<std::shared_ptr<CObject>> & objects) override;
+    void update(CEventQueue & events, const CTileGrid & tileSet,
+                const CSpatialGrid & grid);
 
     /**
      * @brief Create events
@@ -36,9 +36,9 @@ public:
      * When in collision with a player, create event DOOR_REACHED, so the game could
      * continue to another level
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects) override;
+    void createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid);
 };
\ No newline at end of file
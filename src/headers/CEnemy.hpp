@@ -5,6 +5,8 @@
 #include "GameConstants.hpp"
 #include "CObject.hpp"
 #include "Utilities.hpp"
+#include "CRandom.hpp"
+#include "CFlowField.hpp"
 
 /**
  * @brief The available directions of movement
@@ -21,7 +23,7 @@ enum EDirection
 /**
  * @brief Takes care of enemy instances
  */
-class CEnemy : public CObject
+class CEnemy final : public CObject
 {
 public:
     /**
@@ -30,21 +32,24 @@ public:
      * @param position the position on the screen window
      * @param tile the tile type in map
      * @param texture the sprite to render
+     * @param random the random number generator of the game - decides the movement
+     * @param chase the distances to the players to chase them, nullptr to walk at random
      */
     CEnemy(const std::pair<int,int> & position, const ETileType & tile,
-           const std::shared_ptr<CRenderWindow::CTexture> & texture);
+           const std::shared_ptr<CRenderWindow::CTexture> & texture, CRandom & random,
+           const CFlowField * chase = nullptr);
 
     /**
      * @brief Updates the object according to events
      * 
-     * Move and render itself each time frame
+     * Move itself each time frame
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void update(Events & events, const TileSet & tileSet,
-                const std::list<std::shared_ptr<CObject>> & objects) override;
+    void update(CEventQueue & events, const CTileGrid & tileSet,
+                const CSpatialGrid & grid);
 
     /**
      * @brief Create events
@@ -55,11 +60,11 @@ public:
      * In case it was the last enemy standing, create an event ENEMIES_DEAD,
      * so the object manager knows to create a door to another level.
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects) override;
+    void createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid);
 
     /**
      * @brief Retuns the position on the tile map
@@ -71,17 +76,37 @@ public:
      */
     std::pair<int,int> getTilePos() const override;
 
+    /**
+     * @brief Writes the state of the enemy into a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void save(CSnapshot & snapshot) const override;
+
+    /**
+     * @brief Reads the state of the enemy from a snapshot
+     * 
+     * @param snapshot the snapshot
+     * @warning Throws an invalid_argument when the direction is unknown
+     */
+    void load(CSnapshot & snapshot) override;
+
 private:
     int frameNumber;                            /**< The number of frames for which the enemy moves in a certain direction */
     std::set<EDirection> availableDirections;   /**< The directions which haven't been tried yet */
     EDirection currentDirection;                /**< The current direction of movement */
+    CRandom * random;                           /**< The random number generator of the game */
+    const CFlowField * chase;                   /**< The distances to the players, nullptr when the enemy walks at random */
 
     // Constants to specify the collision box, chosen based on the dimensions
     // of the enemies sprite
-    const double xBox = 0.25;
-    const double yBox = 0.15;
-    const double wBox = 0.5;
-    const double hBox = 0.2;
+    static constexpr double xBox = 0.25;
+    static constexpr double yBox = 0.15;
+    static constexpr double wBox = 0.5;
+    static constexpr double hBox = 0.2;
+
+    // The most tiles the enemy walks in one direction
+    static constexpr int maxWalk = 11;
 
     /**
      * @brief Simple AI for the enemy's movement
@@ -91,15 +116,26 @@ private:
      * It does not voluntarily step into an ongoing explosion, the enemy must be caught into it
      * 
      * @param tileSet the tiles on the map - needed for collisions
-     * @param objects the objects on the map
+     * @param grid the objects on the map sorted into tiles
      */
-    void move(const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects);
+    void move(const CTileGrid & tileSet, const CSpatialGrid & grid);
 
     /**
      * @brief Set a random direction and random duration of moving that way
+     * 
+     * A chasing enemy standing on a tile steps onto a neighbouring tile closer to a player instead,
+     * it walks at random only when no player can be reached
      */
     void setDirection();
 
+    /**
+     * @brief Chooses one of the available directions leading closer to a player
+     * 
+     * @return true - a direction was chosen, the enemy walks one tile that way
+     * @return false - no available direction leads closer
+     */
+    bool chasePlayers();
+
     /**
      * @brief Specifies the collision box of the enemy
      */
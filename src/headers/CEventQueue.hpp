@@ -0,0 +1,147 @@
+#pragma once
+
+#include <vector>
+#include <variant>
+#include <utility>
+#include <algorithm>
+
+#include "EEvent.hpp"
+#include "EBonusType.hpp"
+#include "ETileType.hpp"
+#include "CSnapshot.hpp"
+
+/**
+ * @brief Data of the PLACE_BOMB event
+ */
+struct SPlaceBomb
+{
+    std::pair<int, int> position;   /**< The tile on which the bomb is placed */
+    int size;                       /**< The size of its explosion */
+};
+
+/**
+ * @brief Data of the PLACE_EXPLOSION event
+ */
+struct SPlaceExplosion
+{
+    std::pair<int, int> position;   /**< The tile on which the explosion is placed */
+};
+
+/**
+ * @brief Data of the GET_BONUS event
+ */
+struct SGetBonus
+{
+    EBonusType bonus;               /**< The type of the bonus */
+    int strength;                   /**< The strength of the bonus */
+    ETileType player;               /**< The player who picked it up */
+};
+
+/**
+ * @brief Data of the POINTS event
+ */
+struct SPoints
+{
+    int points;                     /**< The number of points to add */
+};
+
+/**
+ * @brief Data of the PLAYER_DEAD event
+ */
+struct SPlayerDead
+{
+    ETileType player;               /**< The player who died */
+};
+
+/**
+ * @brief An event and its data, the type of the data depends on the type of the event
+ * 
+ * DOOR_REACHED, ENEMIES_DEAD and ENEMY_DEAD don't carry any data
+ */
+struct SEvent
+{
+    EEvent type;                    /**< The type of the event */
+    std::variant<std::monostate, SPlaceBomb, SPlaceExplosion, SGetBonus, SPoints, SPlayerDead> data;    /**< The data of the event */
+    bool consumed;                  /**< The event has been carried out and will be removed */
+};
+
+/**
+ * @brief A queue of the events created by the objects
+ * 
+ * The events are stored in one contiguous array, which is allocated only once.
+ * Carried out events are just flagged as consumed and all of them get removed
+ * at once, so creating and removing events doesn't allocate any memory
+ */
+class CEventQueue
+{
+public:
+    /**
+     * @brief CEventQueue constructor
+     * 
+     * @param capacity the number of events, for which the memory is allocated in advance
+     */
+    CEventQueue(const size_t & capacity = 1024);
+
+    /**
+     * @brief Adds an event at the end of the queue
+     * 
+     * @param type the type of the event
+     * @param data the data of the event
+     */
+    template <typename T = std::monostate>
+    void push(const EEvent & type, const T & data = T());
+
+    /**
+     * @brief Removes all of the consumed events, keeps the order of the rest
+     */
+    void removeConsumed();
+
+    /**
+     * @brief Removes all of the events
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of events in the queue
+     * 
+     * @return the number of events
+     */
+    size_t size() const;
+
+    /**
+     * @brief Writes all of the events and their data into a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void save(CSnapshot & snapshot) const;
+
+    /**
+     * @brief Replaces the events with the ones read from a snapshot
+     * 
+     * @param snapshot the snapshot
+     * @warning Throws an invalid_argument when an event has an unknown type or data of another type
+     */
+    void load(CSnapshot & snapshot);
+
+    std::vector<SEvent>::iterator begin();
+    std::vector<SEvent>::iterator end();
+    std::vector<SEvent>::const_iterator begin() const;
+    std::vector<SEvent>::const_iterator end() const;
+
+private:
+    std::vector<SEvent> events;     /**< The events in the order in which they were created */
+
+    /**
+     * @brief Returns the index of the data in the variant, which the events of a type carry
+     * 
+     * @param type the type of the event
+     * @return the index of the data
+     */
+    static size_t dataIndex(const EEvent & type);
+};
+
+template <typename T>
+void CEventQueue::push(const EEvent & type, const T & data)
+{
+    this->events.push_back(SEvent{type, data, false});
+}
\ No newline at end of file
@@ -5,7 +5,7 @@
 /**
  * @brief Takes care of explosion instances
  */
-class CExplosion : public CObject
+class CExplosion final : public CObject
 {
 public:
     /**
@@ -21,15 +21,29 @@ public:
     /**
      * @brief Updates the object according to events
      * 
-     * Render itself, after a certain amount of time frames, flag itself to get removed
+     * After a certain amount of time frames, flag itself to get removed
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void update(Events & events,
-                const TileSet & tileSet,
-                const std::list<std::shared_ptr<CObject>> & objects) override;
+    void update(CEventQueue & events,
+                const CTileGrid & tileSet,
+                const CSpatialGrid & grid);
+
+    /**
+     * @brief Writes the state of the explosion into a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void save(CSnapshot & snapshot) const override;
+
+    /**
+     * @brief Reads the state of the explosion from a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void load(CSnapshot & snapshot) override;
 
 private:
     int duration;   /**< The amount of time frames for which the instance lives */
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <climits>
+
+#include "CTileGrid.hpp"
+
+/**
+ * @brief The distances from every tile of the map to the nearest player
+ * 
+ * One breadth-first search from all of the players at once fills the whole map,
+ * walking around walls and breakables. Any number of enemies then find the way
+ * to a player by stepping onto the neighbouring tile closer to it, which costs
+ * a single look up. The search runs again only when a player moves onto another
+ * tile or a tile of the map changes
+ */
+class CFlowField
+{
+public:
+    static constexpr int unreachable = INT_MAX;     /**< The distance of the tiles no player can be reached from */
+
+    /**
+     * @brief CFlowField constructor
+     */
+    CFlowField();
+
+    /**
+     * @brief Makes the next update search again, ex.: when a tile of the map changes
+     */
+    void invalidate();
+
+    /**
+     * @brief Searches the map again, when the players moved onto other tiles or the map changed
+     * 
+     * @param tiles the tiles of the map
+     * @param targets the tiles of the players
+     */
+    void update(const CTileGrid & tiles, const std::vector<std::pair<int,int>> & targets);
+
+    /**
+     * @brief Returns the number of steps from a tile to the nearest player
+     * 
+     * @param x x coordinate in tiles
+     * @param y y coordinate in tiles
+     * @return the distance, unreachable when there is no way or the tile is out of the map
+     */
+    int at(const int & x, const int & y) const;
+
+private:
+    int width;                                  /**< The width of the map in tiles */
+    int height;                                 /**< The height of the map in tiles */
+    std::vector<int> distances;                 /**< The distances row by row */
+    std::vector<int> frontier;                  /**< The queue of the search, kept so its memory is reused */
+    std::vector<std::pair<int,int>> targets;    /**< The tiles of the players during the last search */
+    bool dirty;                                 /**< The map changed since the last search */
+};
\ No newline at end of file
@@ -7,11 +7,20 @@
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <chrono>
 
 #include "CRenderWindow.hpp"
 #include "CUserInterface.hpp"
 #include "CObjectEventManager.hpp"
 #include "CMap.hpp"
+#include "CClock.hpp"
+#include "CRandom.hpp"
+#include "CConfig.hpp"
+#include "CSnapshot.hpp"
+#include "CInput.hpp"
+#include "CReplay.hpp"
+#include "CProfiler.hpp"
+#include "CAudio.hpp"
 #include "GameConstants.hpp"
 
 /**
@@ -38,6 +47,33 @@ public:
      */
     ~CGame();
 
+    /**
+     * @brief Records every game into a replay file, each game rewrites the previous one
+     * 
+     * @param filePath the path to the replay file
+     */
+    void recordInto(const std::string & filePath);
+
+    /**
+     * @brief Plays a replay at normal speed instead of letting the players play
+     * 
+     * The game closes once the replay ends
+     * 
+     * @param filePath the path to the replay file
+     */
+    void playReplay(const std::string & filePath);
+
+    /**
+     * @brief Profiles the phases of every frame
+     * 
+     * The last frames are written into the file as a Chrome trace, once the game ends.
+     * A frame longer than frameDelay is captured together with the frames around it
+     * into a file of its own (trace.json -> trace-frame123.json)
+     * 
+     * @param filePath the path to the trace file
+     */
+    void profileInto(const std::string & filePath);
+
     /**
      * @brief Starts the game loop
      */
@@ -47,7 +83,7 @@ public:
      * @brief Handles user induced events
      * 
      * Events:  - Clicking the X button on the game window - quit the game
-     *          - Pressing F5 in singleplayer mode - save the game
+     *          - Pressing F5 in singleplayer mode - save the game, both as a map and as a snapshot
      *          - Pressing ESC during a game - jump to the main menu and discard the current game
      *          - Pressing a button in the main menu - does something according to the button pressed
      */
@@ -68,6 +104,9 @@ public:
 
     /**
      * @brief Starts a new game according to the specified game mode
+     * 
+     * The game starts from the seed in the configuration file, or from a random one
+     * when it is 0. The seed is printed, so the game can be played again
      */
     void newGame();
 
@@ -75,10 +114,20 @@ private:
     bool gameOn;                                    /**< Flag that keeps the game loop going */
     bool startGame;                                 /**< Flag that starts the game */
     EGameMode mode;                                 /**< The current game mode */
+    CRandom random;                                 /**< The random number generator, seeded again for every new game */
     CRenderWindow * window;                         /**< Holds rendering and it's logic */
+    std::shared_ptr<CConfig> config;                /**< Holds the configuration loaded from the file */
     std::shared_ptr<CMap> map;                      /**< Holds the map manager */
     std::shared_ptr<CObjectEventManager> manager;   /**< Holds the game field manager */
     std::shared_ptr<CUserInterface> UI;             /**< Holds the main menu user interface */
+    CSnapshot quicksave;                            /**< The snapshot written on a quicksave, kept so its memory is reused */
+    CInput input;                                   /**< Turns the keyboard and the controllers into the input of the players */
+    CReplay replay;                                 /**< The replay being recorded or played */
+    std::string recordFile;                         /**< Where to record the games, empty when they aren't recorded */
+    std::string replayFile;                         /**< The replay to play, empty when the players play */
+    std::string profileFile;                        /**< Where to write the profile, empty when the game isn't profiled */
+    std::shared_ptr<CProfiler> profiler;            /**< Records the phases of the frames, when profiling */
+    std::shared_ptr<CAudio> audio;                  /**< Plays the sounds of the events, nullptr when there is no audio */
 
     /**
      * @brief Initialize SDL
@@ -89,9 +138,71 @@ private:
     static void initSDL();
 
     /**
-     * @brief Checks, whether the data in the configuration file is valid
+     * @brief Checks, whether the game constants are valid
+     * 
+     * The data in the configuration file is checked by CConfig
      * 
-     * @warning Throws an error when it isn't
+     * @warning Throws an error when they aren't
      */
     static void checkConfig();
+
+    /**
+     * @brief Saves the score of a finished singleplayer game, if it beats the high score
+     */
+    void saveHighScore();
+
+    /**
+     * @brief Returns the path to the snapshot written next to the save file
+     * 
+     * @return the path
+     */
+    std::string stateFile() const;
+
+    /**
+     * @brief Continues the saved game from its snapshot
+     * 
+     * @return true - the game was restored
+     * @return false - there is no usable snapshot, the game needs to be loaded from the map
+     */
+    bool loadState();
+
+    /**
+     * @brief Starts recording the game that has just started, if the games are recorded
+     */
+    void startRecording();
+
+    /**
+     * @brief Writes the recorded game into the replay file, if a game is being recorded
+     */
+    void stopRecording();
+
+    /**
+     * @brief Starts playing the replay
+     * 
+     * @return true - the replay is playing
+     * @return false - the replay could not be loaded
+     */
+    bool startReplay();
+
+    /**
+     * @brief Reports, whether the replay ended in the recorded state, and closes the game
+     */
+    void finishReplay();
+
+    /**
+     * @brief Ends the frame of the profiler, stops profiling when a capture can't be written
+     */
+    void endProfiledFrame();
+
+    /**
+     * @brief Writes the profile into its file and stops profiling
+     */
+    void saveProfile();
+
+    /**
+     * @brief Writes how long the phases of the startup took, when profiling
+     * 
+     * @param runStart the moment the game started to run
+     */
+    void reportStartup(const std::chrono::steady_clock::time_point & runStart) const;
 };
\ No newline at end of file
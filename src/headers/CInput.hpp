@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <atomic>
+#include <SDL2/SDL.h>
+
+#include "EInput.hpp"
+#include "CSpscQueue.hpp"
+
+/**
+ * @brief The input of both players in one time frame
+ * 
+ * The players only ever see this, never the keyboard, so the same time frames
+ * can be fed back from a replay
+ */
+struct SInputFrame
+{
+    uint8_t players[2];     /**< The actions of PLAYER1 and PLAYER2, each a combination of EInput bits */
+
+    bool operator == (const SInputFrame & other) const;
+    bool operator != (const SInputFrame & other) const;
+};
+
+/**
+ * @brief A key or a button of a player pressed or released
+ */
+struct SInputEvent
+{
+    Uint32 timestamp;   /**< When it happened, in SDL ticks */
+    uint8_t player;     /**< 0 for PLAYER1, 1 for PLAYER2 */
+    uint8_t action;     /**< The EInput bit of the action */
+    bool pressed;       /**< Pressed or released */
+};
+
+/**
+ * @brief Turns the keyboard and the game controllers into the input of the players
+ * 
+ * An event watch records every key and button the moment SDL pumps it, with its timestamp,
+ * into a lock-free queue. The time frames take the events which happened until their end.
+ * A press is kept until a time frame takes it, so even a key pressed and released
+ * between two time frames reaches the game. The first controller plays for PLAYER1,
+ * the second one for PLAYER2, both of them can use the keyboard as well
+ */
+class CInput
+{
+public:
+    /**
+     * @brief CInput constructor
+     */
+    CInput();
+
+    CInput(const CInput & orig) = delete;
+    CInput & operator = (const CInput & orig) = delete;
+
+    /**
+     * @brief Stops recording the input and closes the game controllers
+     */
+    ~CInput();
+
+    /**
+     * @brief Starts recording the input, SDL must be initialized
+     * 
+     * The controllers connected already get announced as new ones by SDL
+     */
+    void start();
+
+    /**
+     * @brief Stops recording the input and closes the game controllers, before SDL quits
+     */
+    void stop();
+
+    /**
+     * @brief Opens the connected game controllers and closes the disconnected ones
+     * 
+     * @param event the event polled by the game
+     */
+    void handleEvent(const SDL_Event * event);
+
+    /**
+     * @brief Turns an SDL event into the input events of the players and queues them
+     * 
+     * Called by the event watch on the thread which pumps the events,
+     * it must be the only thread calling it
+     * 
+     * @param event the event
+     */
+    void record(const SDL_Event * event);
+
+    /**
+     * @brief Returns the input of a time frame
+     * 
+     * Takes the events which happened until the end of the time frame, the later ones stay queued
+     * 
+     * @param until the end of the time frame, in SDL ticks
+     * @return the actions held at the end of the time frame or pressed during it
+     */
+    SInputFrame poll(const Uint32 & until);
+
+    /**
+     * @brief Keeps pumping the events until the deadline, instead of sleeping
+     * 
+     * The events get their timestamps when they are pumped, so they are pumped every millisecond
+     * 
+     * @param deadline the time to wait for, in SDL ticks
+     */
+    void pumpUntil(const Uint32 & deadline) const;
+
+private:
+    /**
+     * @brief The keys of one player
+     */
+    struct SBinding
+    {
+        SDL_Scancode up;        /**< The key used to move up */
+        SDL_Scancode down;      /**< The key used to move down */
+        SDL_Scancode left;      /**< The key used to move left */
+        SDL_Scancode right;     /**< The key used to move right */
+        SDL_Scancode bomb;      /**< The key used to place bombs */
+    };
+
+    static const std::array<SBinding, 2> bindings;  /**< The keys of PLAYER1 and PLAYER2 */
+
+    // How far a stick must be pushed to move the player
+    static constexpr Sint16 stickThreshold = 16000;
+
+    CSpscQueue<SInputEvent, 256> queue;                     /**< The input events waiting for their time frame */
+    SInputFrame held;                                       /**< The actions held after the taken events */
+    SInputFrame latched;                                    /**< The actions pressed since the last time frame */
+    std::array<SDL_GameController *, 2> controllers;        /**< The controllers of the players, nullptr when missing */
+    std::array<std::atomic<SDL_JoystickID>, 2> controllerIds;   /**< The instance IDs of the controllers read by record(), -1 when missing */
+    std::array<uint8_t, 2> sticks;                          /**< The directions the sticks point to, known only to record() */
+    bool started;                                           /**< The event watch is added */
+
+    /**
+     * @brief The event watch, passes the events to record()
+     * 
+     * @param input the CInput
+     * @param event the event
+     * @return always 1, the watch doesn't filter the events
+     */
+    static int watch(void * input, SDL_Event * event);
+
+    /**
+     * @brief Queues the change of a stick's direction as releases and presses
+     * 
+     * @param player the player of the controller
+     * @param timestamp when the stick moved
+     * @param mask the directions of the moved axis
+     * @param direction the direction the axis points to now, 0 in the middle
+     */
+    void recordStick(const uint8_t & player, const Uint32 & timestamp, const uint8_t & mask, const uint8_t & direction);
+};
\ No newline at end of file
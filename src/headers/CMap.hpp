@@ -1,7 +1,6 @@
 #pragma once
 
 #include <vector>
-#include <set>
 #include <list>
 #include <algorithm>
 #include <fstream>
@@ -16,6 +15,8 @@
 #include "CObject.hpp"
 #include "GameConstants.hpp"
 #include "Utilities.hpp"
+#include "CRandom.hpp"
+#include "CConfig.hpp"
 
 /**
  * @brief Manages the game map
@@ -30,9 +31,11 @@ public:
      * @brief Create a new map
      * 
      * @param mode the game mode
-     * @param saveFile the path to the save file
+     * @param random the random number generator of the game - decides the layout of the map
+     * @param config the configuration of the game
+     * @param saveFile the path to the save file, empty for the one in the configuration
      */
-    CMap(const EGameMode & mode, const std::string & saveFile = loadData(config, "Save file", true).str());
+    CMap(const EGameMode & mode, CRandom & random, const CConfig & config, const std::string & saveFile = "");
 
     /**
      * @brief Saves the map and the score into a file
@@ -59,12 +62,17 @@ public:
     std::pair<Map, int> getMap() const;
 
 private:
+    int width;                                      /**< The width of the map in tiles */
+    int height;                                     /**< The height of the map in tiles */
     Map map;                                        /**< The game map */
-    std::set<std::pair<int, int>> availableTiles;   /**< The tiles on which the entities can step on */
-    static int numberOfBreakables;                  /**< The nuber of breakables to be generated */
-    static int numberOfEnemies;                     /**< The number of enemies to be generated in singleplayer mode */
+    std::vector<int> availableTiles;                /**< The indices (y * width + x) of the empty tiles not taken yet, in no order */
+    std::vector<bool> reserved;                     /**< The tiles around the players, which must stay empty */
+    int freeTiles;                                  /**< The number of available tiles, which aren't reserved */
+    int numberOfBreakables;                         /**< The nuber of breakables to be generated */
+    int numberOfEnemies;                            /**< The number of enemies to be generated in singleplayer mode */
     int score;                                      /**< The score in singleplayer mode */
     std::string saveFile;                           /**< Path to the save file */
+    CRandom & random;                               /**< The random number generator of the game */
 
     /**
      * @brief Set a tile to a specified type
@@ -101,18 +109,20 @@ private:
     /**
      * @brief Takes a random tile from the available tiles pool and sets it to a specified type
      * 
-     * The tile is then removed from the pool of available tiles
+     * The tile is then removed from the pool of available tiles by swapping it with the last one.
+     * The reserved tiles stay in the pool until they are picked, then they are removed the same way
+     * and another tile is picked, so every tile costs constant time
      * 
      * @param tileType the type of the tile
      * @return the chosen tile
+     * @warning there must be a free tile left
      */
     std::pair<int, int> takeRandomTile(const ETileType & tileType);
 
     /**
      * @brief Utility function for setPlayer()
      * 
-     * Takes the adjacent tiles of the input center tile an if they are in
-     * the available tiles pool, removes them.
+     * Reserves the adjacent tiles of the input center tile, if they are still available.
      * That way the player can always start the game properly
      * 
      * By adjacent tiles we mean this:
@@ -146,5 +156,5 @@ private:
      * 
      * Throws an error
      */
-    static void mapLoadError();
+    void mapLoadError() const;
 };
\ No newline at end of file
@@ -8,12 +8,17 @@
 
 #include "GameConstants.hpp"
 #include "CRenderWindow.hpp"
-#include "CTile.hpp"
+#include "CTileGrid.hpp"
+#include "CSpatialGrid.hpp"
 #include "ETileType.hpp"
-#include "EEvent.hpp"
+#include "CEventQueue.hpp"
+#include "CSnapshot.hpp"
 
 /**
- * @brief An abstract class for all objects on map
+ * @brief A base class for all objects on map
+ * 
+ * The objects are stored by value, each kind in its own array, so they don't need
+ * a common virtual update() - every kind has its own update() instead
  */
 class CObject
 {
@@ -45,27 +50,22 @@ public:
 
     /**
      * @brief Renders the object on screen depending on its position
-     */
-    void render() const;
-
-    /**
-     * @brief Updates the object according to events
      * 
-     * @param events the list of events
-     * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * Rendering is kept apart from update(), so the game can be simulated
+     * without a renderer. The position is interpolated between the last two
+     * time frames, so the movement looks smooth on any display
+     * 
+     * @param alpha how far the rendered frame is between the last and the next time frame (0 to 1)
      */
-    virtual void update(Events & events, const TileSet & tileSet,
-                        const std::list<std::shared_ptr<CObject>> & objects) = 0;
+    virtual void render(const double & alpha = 1) const;
 
     /**
-     * @brief Creates new events
+     * @brief Returns the position between the last two time frames, where the object gets rendered
      * 
-     * @param events the list of events
-     * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param alpha how far the rendered frame is between the last and the next time frame (0 to 1)
+     * @return the position on the screen
      */
-    virtual void createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects);
+    std::pair<int, int> interpolate(const double & alpha) const;
 
     /**
      * @brief Returns the position of the object in a 2D vector of tiles
@@ -76,14 +76,43 @@ public:
      */
     virtual std::pair<int, int> getTilePos() const;
 
+    /**
+     * @brief Returns the position of the object on the screen
+     * 
+     * @return the position in pixels
+     */
+    std::pair<int, int> getPosition() const;
+
+    /**
+     * @brief Writes the state of the object into a snapshot
+     * 
+     * The tile type is written by the object manager, so it knows which object to construct
+     * 
+     * @param snapshot the snapshot
+     */
+    virtual void save(CSnapshot & snapshot) const;
+
+    /**
+     * @brief Reads the state of the object from a snapshot
+     * 
+     * The object must be registered in the grid again afterwards, its collision box changes
+     * 
+     * @param snapshot the snapshot
+     */
+    virtual void load(CSnapshot & snapshot);
+
     friend class CObjectEventManager;
+    friend class CObjectStore;
+    friend class CSpatialGrid;
 
 protected:
     bool toRemove;                                      /**< Utility variable for deleting objects */
     std::pair<int, int> position;                       /**< The position of the object on the screen */
+    std::pair<int, int> previousPosition;               /**< The position in the previous time frame, needed for rendering */
     std::shared_ptr<CRenderWindow::CTexture> texture;   /**< The texture of the object */
     SDL_Rect box;                                       /**< The collision box of the object */
     ETileType tile;                                     /**< Specifies the tile type on the map */
+    SDL_Rect cells;                                     /**< The range of map tiles in which the object is registered */
 
     /**
      * @brief Sets up the collision box
@@ -93,6 +122,8 @@ protected:
     /**
      * @brief Checks for collisions with walls
      * 
+     * Only the tiles overlapping the collision box are checked
+     * 
      * Parametres u, d, l, r serve for changing the collision tolerance
      * They are used by the objects, whose collision box is not tileWidth * tileWidth
      * 
@@ -100,7 +131,7 @@ protected:
      * @return true - collides with a wall
      * @return false - otherwise
      */
-    bool wallCollision(const TileSet & tileSet,
+    bool wallCollision(const CTileGrid & tileSet,
                        const double & u = 0,
                        const double & d = 0,
                        const double & l = 0,
@@ -109,15 +140,17 @@ protected:
     /**
      * @brief Checks for collision with other objects
      * 
+     * Only the objects in the tiles around the collision box are checked
+     * 
      * Parametres u, d, l, r serve for changing the collision tolerance
      * They are used by the objects, whose collision box is not tileWidth * tileWidth
      * 
-     * @param objects the list of objects
+     * @param grid the objects sorted into the map tiles
      * @param tileType the tile type of the other object we check collision for
      * @return the pointer to the colliding object
      * @return nullpointer if no such object is in collision
      */
-    CObject * objectCollision(const std::list<std::shared_ptr<CObject>> & objects,
+    CObject * objectCollision(const CSpatialGrid & grid,
                               const ETileType & tileType,
                               const double & u = 0,
                               const double & d = 0,
@@ -1,17 +1,20 @@
 #pragma once
 
-#include <list>
-#include <tuple>
+#include <array>
 
 #include "CRenderWindow.hpp"
-#include "CTile.hpp"
+#include "CTileGrid.hpp"
 #include "CObject.hpp"
-#include "CPlayer.hpp"
-#include "CEnemy.hpp"
-#include "CDoor.hpp"
-#include "CExplosion.hpp"
-#include "CBomb.hpp"
-#include "CBonus.hpp"
+#include "CObjectStore.hpp"
+#include "CEventQueue.hpp"
+#include "CMap.hpp"
+#include "CRandom.hpp"
+#include "CConfig.hpp"
+#include "CSnapshot.hpp"
+#include "CInput.hpp"
+#include "CProfiler.hpp"
+#include "CCamera.hpp"
+#include "CFlowField.hpp"
 #include "Utilities.hpp"
 #include "EGameMode.hpp"
 #include "EEvent.hpp"
@@ -31,17 +34,45 @@ public:
     /**
      * @brief CObjectEventManager constructor
      * 
-     * @param renderer pointer to the CRenderWindow class - needed for textures
+     * @param config the configuration of the game
+     * @param random the random number generator of the game, it must outlive the manager
+     * @param renderer pointer to the CRenderWindow class - needed for textures,
+     * nullptr runs the game headless (without any textures)
      */
-    CObjectEventManager(CRenderWindow * renderer);
+    CObjectEventManager(const CConfig & config, CRandom & random, CRenderWindow * renderer = nullptr);
+
+    /**
+     * @brief Advances the game by one time frame
+     * 
+     * Loads a new level if needed, updates the playing field and carries out
+     * the events. It never renders anything, so it can run without a window.
+     * The players only act on the given input, so the same inputs always give the same game.
+     * Once the game has ended, nothing changes anymore
+     * 
+     * @param input the input of both players in this time frame
+     */
+    void tick(const SInputFrame & input = SInputFrame{});
+
+    /**
+     * @brief Renders the playing field around the players
+     * 
+     * The camera follows the players, only the tiles and the objects in its views get rendered.
+     * The scores are rendered over the views
+     * 
+     * @param alpha how far the rendered frame is between the last and the next time frame (0 to 1)
+     * @warning Must not be called when running headless
+     */
+    void render(const double & alpha = 1);
 
     /**
      * @brief Update the whole playing field
      * 
-     * Updates the tile set and all of the objects on the playing field
+     * Updates all of the objects on the playing field
      * Removes objects that are flagged to get removed
+     * 
+     * @param input the input of both players in this time frame
      */
-    void update();
+    void update(const SInputFrame & input);
 
     /**
      * @brief Manages events created by the objects
@@ -72,34 +103,110 @@ public:
      */
     const std::pair<Map, int> saveIntoMap() const;
 
+    /**
+     * @brief Writes the complete state of the game into a snapshot
+     * 
+     * Unlike saveIntoMap(), nothing gets lost - the timers of the bombs and explosions,
+     * the directions of the enemies, the exact positions of the players, their bonuses,
+     * the score of both players, the pending events and the state of the random number generator.
+     * Restoring the snapshot continues the game exactly the same way
+     * 
+     * @param snapshot the snapshot, its previous data is replaced
+     */
+    void snapshot(CSnapshot & snapshot) const;
+
+    /**
+     * @brief Replaces the state of the game with the one in a snapshot
+     * 
+     * @param snapshot the snapshot
+     * @warning Throws an invalid_argument when the snapshot is corrupted,
+     * the game must be started again then
+     */
+    void restore(CSnapshot & snapshot);
+
+    /**
+     * @brief Draws all of the tiles again on the next render
+     * 
+     * Needed when the renderer loses the content of its textures.
+     * The background is made again, when the map has other dimensions than before
+     */
+    void invalidateBackground();
+
+    /**
+     * @brief Returns the scores of both players
+     * 
+     * Needed for saving the high score at the end of a singleplayer game
+     * 
+     * @return the score of PLAYER1 and PLAYER2
+     */
+    const std::pair<int,int> & getScores() const;
+
+    /**
+     * @brief Returns the number of duel rounds each player survived alone
+     * 
+     * @return the rounds won by PLAYER1 and PLAYER2
+     */
+    const std::pair<int,int> & getRoundsWon() const;
+
+    /**
+     * @brief Returns the tiles of the map
+     * 
+     * Needed by the bots to find their way
+     * 
+     * @return the tiles
+     */
+    const CTileGrid & getTiles() const;
+
+    /**
+     * @brief Returns the objects on the playing field
+     * 
+     * Needed for reporting how full the object pools got
+     * 
+     * @return the store of objects
+     */
+    const CObjectStore & getStore() const;
+
+    /**
+     * @brief Returns the types of the events carried out since the last call and forgets them
+     * 
+     * Many events of one type in the same time frames count once, so the sounds
+     * of a chain reaction don't pile up. Nothing in the game depends on it,
+     * it isn't a part of the snapshot
+     * 
+     * @return a bit (1 << event type) for each type of event that happened
+     */
+    uint32_t takeFiredEvents();
+
 private:
     CRenderWindow * renderer;                       /**< Pointer to the renderer - we need it so we have access to the textures */
-    std::list<std::shared_ptr<CObject>> objects;    /**< The objects that are currenty on the playing field */
-    Events events;                                  /**< List of current events */
-    TileSet tileSet;                                /**< A 2D vector of tile objects (walls, breakables and empty grass tiles) */
+    const CConfig & config;                         /**< The configuration of the game */
+    CRandom & random;                               /**< The random number generator of the game */
+    CObjectStore store;                             /**< The objects that are currenty on the playing field, each kind in its own array */
+    CEventQueue events;                             /**< Queue of current events */
+    CTileGrid tileSet;                              /**< The tiles on the map (walls, breakables and empty grass tiles) */
+    CFlowField flowField;                           /**< The distances to the players, followed by the chasing enemies */
+    std::vector<std::pair<int,int>> chaseTargets;   /**< The tiles of the players, kept so the memory is reused */
+    std::array<std::shared_ptr<CRenderWindow::CTexture>, BREAKABLE + 1> tileTextures;   /**< The textures of the tiles, indexed by their type */
+    std::unique_ptr<CRenderWindow::CBackground> background;                             /**< The tiles drawn into a texture, nullptr when running headless */
+    CCamera camera;                                 /**< Decides which part of the map is rendered where */
+    std::vector<std::pair<int,int>> cameraTargets;  /**< The middles of the players followed by the camera, kept so the memory is reused */
     std::pair<int,int> currentScore;                /**< Current score, needed for loading and saving the game */
+    std::pair<int,int> roundsWon;                   /**< The duel rounds won by each player */
     EGameMode mode;                                 /**< Current game mode */
     int alivePlayers;                               /**< Alive players - determines the end of the game */
     int aliveEnemies;                               /**< Alive enemies - determines when to create a door */
     int rounds;                                     /**< Number of rounds in duel mode */
-    int bonusChance;                                /**< A percentual chance for a bonus to drop from a destroyed breakable */
+    uint32_t firedEvents;                           /**< The types of the events since takeFiredEvents(), one bit each */
 
     /**
-     * @brief Adds an event to the event list
+     * @brief Renders the objects in a view
      * 
-     * @param event the name of the event
-     * @param position used by events, which need to construct something on a certain position
-     * @param num used by events which need to carry a numerical value - ex.: POINTS
-     * @param obj used by events which need to carry a pointer to an object - ex.: GET_BONUS
-     */
-    void addEvent(const EEvent & event, const std::pair<int, int> & position = {0,0}, const int & num = 0, CObject * obj = nullptr);
-
-    /**
-     * @brief Adds an objects to the list
+     * The objects are found through the spatial grid, so only the tiles in the view are visited
      * 
-     * @param obj pointer to the new object
+     * @param view the part of the map shown, in map pixels
+     * @param alpha how far the rendered frame is between the last and the next time frame (0 to 1)
      */
-    void addObject(CObject * obj);
+    void renderObjects(const SDL_Rect & view, const double & alpha) const;
 
     /**
      * @brief Sets a tile in the tile set
@@ -109,4 +216,30 @@ private:
      * @param tileType the type of tile to which will be set
      */
     void setTile(const int & x, const int & y, const ETileType & tileType);
+
+    /**
+     * @brief Constructs an object of a given tile type
+     * 
+     * @param tile the tile type of the object
+     * @param position the position in tiles
+     * @return the new object, valid until another object is added
+     * @warning Throws an invalid_argument when the tile type is not an object
+     */
+    CObject * addObject(const ETileType & tile, const std::pair<int,int> & position);
+
+    /**
+     * @brief Gets a texture of a specified tile
+     * 
+     * @param tile the tile type
+     * @return the texture, nullptr when running headless
+     */
+    std::shared_ptr<CRenderWindow::CTexture> getTexture(const ETileType & tile) const;
+
+    /**
+     * @brief Gets a texture of a specified text
+     * 
+     * @param textType the text type
+     * @return the texture, nullptr when running headless
+     */
+    std::shared_ptr<CRenderWindow::CText> getText(const ETextType & textType) const;
 };
\ No newline at end of file
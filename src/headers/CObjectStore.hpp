@@ -0,0 +1,161 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "CSpatialGrid.hpp"
+#include "CReservedArray.hpp"
+#include "CPlayer.hpp"
+#include "CEnemy.hpp"
+#include "CDoor.hpp"
+#include "CExplosion.hpp"
+#include "CBomb.hpp"
+#include "CBonus.hpp"
+
+/**
+ * @brief Stores the objects on the playing field by value, each kind in its own array
+ * 
+ * Every kind of object is iterated as a contiguous array without any virtual calls,
+ * so the cost of a time frame depends only on the number of living objects of each kind.
+ * The objects move in memory when an array grows or when an object gets removed,
+ * the store keeps the grid of tiles up to date with that.
+ * 
+ * Bombs, explosions and bonuses only live for a few seconds, so their arrays are reserved
+ * in advance - the game doesn't allocate any memory for them while they fit
+ */
+class CObjectStore
+{
+public:
+    std::vector<CDoor> doors;                  /**< DOOR objects */
+    CReservedArray<CBonus> bonuses;            /**< BONUS objects, they come and go during the game */
+    CReservedArray<CBomb> bombs;               /**< BOMB objects, they come and go during the game */
+    CReservedArray<CExplosion> explosions;     /**< BOOM objects, they come and go during the game */
+    std::vector<CEnemy> enemies;               /**< ENEMY objects */
+    std::vector<CPlayer> players;              /**< PLAYER1 and PLAYER2 objects */
+    CSpatialGrid grid;                         /**< All of the objects sorted into the map tiles */
+
+    /**
+     * @brief Removes all of the objects
+     * 
+     * @param width the width of the map in tiles
+     * @param height the height of the map in tiles
+     */
+    void clear(const int & width, const int & height);
+
+    /**
+     * @brief Reserves the arrays of the short-lived objects
+     * 
+     * @param bombs the number of bombs
+     * @param explosions the number of explosions
+     * @param bonuses the number of bonuses
+     */
+    void reserve(const int & bombs, const int & explosions, const int & bonuses);
+
+    /**
+     * @brief Constructs a new object at the end of its array and registers it in the grid
+     * 
+     * @param bucket the array of the object's kind
+     * @param args the arguments of the object's constructor
+     */
+    template <typename Bucket, typename ... Args>
+    void add(Bucket & bucket, Args && ... args);
+
+    /**
+     * @brief Removes all of the objects flagged to get removed
+     * 
+     * The order of the remaining objects is kept
+     */
+    void removeFlagged();
+
+    /**
+     * @brief Calls a function for each array of objects
+     * 
+     * The arrays are visited in the order in which they are updated and rendered:
+     * doors, bonuses, bombs, explosions, enemies and players last
+     * 
+     * @param function the function taking an array of objects
+     */
+    template <typename F>
+    void forEachBucket(F && function);
+
+    /**
+     * @brief Calls a function for each array of objects
+     * 
+     * @param function the function taking an array of objects
+     */
+    template <typename F>
+    void forEachBucket(F && function) const;
+
+private:
+    /**
+     * @brief Removes the objects flagged to get removed from one array
+     * 
+     * @param bucket the array of objects
+     */
+    template <typename Bucket>
+    void sweep(Bucket & bucket);
+};
+
+template <typename Bucket, typename ... Args>
+void CObjectStore::add(Bucket & bucket, Args && ... args)
+{
+    // The objects move in memory when the array grows, they need to be registered again
+    bool grows = bucket.size() == bucket.capacity();
+    if (grows)
+        for (auto & obj : bucket)
+            this->grid.remove(&obj);
+
+    bucket.emplace_back(std::forward<Args>(args)...);
+
+    if (grows)
+        for (auto & obj : bucket)
+            this->grid.insert(&obj);
+    else
+        this->grid.insert(&bucket.back());
+}
+
+template <typename F>
+void CObjectStore::forEachBucket(F && function)
+{
+    function(this->doors);
+    function(this->bonuses);
+    function(this->bombs);
+    function(this->explosions);
+    function(this->enemies);
+    function(this->players);
+}
+
+template <typename F>
+void CObjectStore::forEachBucket(F && function) const
+{
+    function(this->doors);
+    function(this->bonuses);
+    function(this->bombs);
+    function(this->explosions);
+    function(this->enemies);
+    function(this->players);
+}
+
+template <typename Bucket>
+void CObjectStore::sweep(Bucket & bucket)
+{
+    size_t kept = 0;
+
+    for (size_t i = 0; i < bucket.size(); ++ i)
+    {
+        if (bucket[i].toRemove)
+        {
+            this->grid.remove(&bucket[i]);
+            continue;
+        }
+        // Close the gap after the removed objects
+        if (kept != i)
+        {
+            bucket[kept] = std::move(bucket[i]);
+            this->grid.relocate(&bucket[i], &bucket[kept]);
+        }
+        ++ kept;
+    }
+
+    bucket.erase(bucket.begin() + kept, bucket.end());
+}
\ No newline at end of file
@@ -5,11 +5,12 @@
 #include "CObject.hpp"
 #include "CScore.hpp"
 #include "EBonusType.hpp"
+#include "EInput.hpp"
 
 /**
  * @brief Takes care of player instances
  */
-class CPlayer : public CObject
+class CPlayer final : public CObject
 {
 public:
     /**
@@ -20,38 +21,49 @@ public:
      * @param texture the sprite to render 
      * @param score the score of the player
      * @param textSource pointer to the text texture which shows the score
-     * @param up the key used to move up
-     * @param down the key used to move down
-     * @param left the key used to move left
-     * @param right the key used to move right
-     * @param bomb the key used to place bombs
      */
     CPlayer(const std::pair<int,int> & position,
             const ETileType & tile,
             const std::shared_ptr<CRenderWindow::CTexture> & texture,
             int * score,
-            const std::shared_ptr<CRenderWindow::CText> & textSource,
-            const SDL_Scancode & up,
-            const SDL_Scancode & down,
-            const SDL_Scancode & left,
-            const SDL_Scancode & right,
-            const SDL_Scancode & bomb);
+            const std::shared_ptr<CRenderWindow::CText> & textSource);
+
+    /**
+     * @brief Sets the actions of the player in the next time frame
+     * 
+     * @param input a combination of EInput bits
+     */
+    void setInput(const uint8_t & input);
+
+    /**
+     * @brief Returns the size of the player's explosions
+     * 
+     * @return the number of tiles the explosion reaches in each direction
+     */
+    int getBombSize() const;
+
+    /**
+     * @brief Returns the speed of the player
+     * 
+     * @return the number of pixels moved in a time frame
+     */
+    int getSpeed() const;
 
     /**
      * @brief Updates the object according to events
      * 
-     * Render itself, the score and move according to the keys pressed
+     * Move according to the input
      * 
      * React to events:
      *  - POINTS - add points to score
      *  - GET_BONUS - gain a boost according to the bonus type
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void update(Events & events, const TileSet & tileSet,
-                const std::list<std::shared_ptr<CObject>> & objects) override;
+    void update(CEventQueue & events, const CTileGrid & tileSet,
+                const CSpatialGrid & grid);
 
     /**
      * @brief Create events
@@ -61,11 +73,11 @@ public:
      * When a bomb gets placed, create a PLACE_BOMB event. Make sure only one
      * bomb gets placed per one key press
      * 
-     * @param events the list of events
+     * @param events the queue of events
      * @param tileSet the set of tiles on the map
-     * @param objects the list of existing objects
+     * @param grid the existing objects sorted into the map tiles
      */
-    void createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects) override;
+    void createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid);
 
     /**
      * @brief Retuns the position on the tile map
@@ -77,35 +89,52 @@ public:
      */
     std::pair<int,int> getTilePos() const override;
 
+    /**
+     * @brief Renders the score of the player
+     * 
+     * Each player renders its score on a different side of the window, over the map
+     */
+    void renderScore() const;
+
+    /**
+     * @brief Writes the state of the player, its score is saved by the object manager into a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void save(CSnapshot & snapshot) const override;
+
+    /**
+     * @brief Reads the state of the player from a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void load(CSnapshot & snapshot) override;
+
 private:
-    SDL_Scancode up;    /**< The key used to move up */
-    SDL_Scancode down;  /**< The key used to move down */
-    SDL_Scancode left;  /**< The key used to move left */
-    SDL_Scancode right; /**< The key used to move right */
-    SDL_Scancode bomb;  /**< The key used to place bombs */
+    uint8_t input;      /**< The actions of the player in this time frame, a combination of EInput bits */
     bool placingBomb;   /**< Flag that ensures only one bomb gets placed per one key press */
     int speed;          /**< The speed of the player */
     int bombSize;       /**< The size of player's explosions */
     CScore score;       /**< Player's score */
 
     // Scaling constants for wall collisions
-    const double upWall    = 0.8;
-    const double downWall  = -0.1;
-    const double leftWall  = 0.1;
-    const double rightWall = 0.1;
+    static constexpr double upWall    = 0.8;
+    static constexpr double downWall  = -0.1;
+    static constexpr double leftWall  = 0.1;
+    static constexpr double rightWall = 0.1;
 
     // Scaling constants for the collision box
-    const double xBox = 0.25;
-    const double yBox = 0.1;
-    const double wBox = 0.5;
-    const double hBox = 0.2;
+    static constexpr double xBox = 0.25;
+    static constexpr double yBox = 0.1;
+    static constexpr double wBox = 0.5;
+    static constexpr double hBox = 0.2;
 
     /**
-     * @brief Changes position according to key presses
+     * @brief Changes position according to the input
      * 
      * @param tileSet the tiles on the map - needed for collisions
      */
-    void move(const TileSet & tileSet);
+    void move(const CTileGrid & tileSet);
 
     /**
      * @brief Specifies the collision box of the player
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <cstdint>
+
+#include "Exceptions.hpp"
+#include "GameConstants.hpp"
+
+/**
+ * @brief Measures where the time of a frame goes
+ * 
+ * The code marks its phases with zones, each zone records when it started and ended
+ * into a ring buffer, which keeps the last records and overwrites the oldest ones.
+ * The records can be written as a Chrome trace (chrome://tracing or ui.perfetto.dev).
+ * 
+ * Only the zones of the thread the profiler is attached to are recorded, in all the other
+ * threads (like the simulated matches) a zone costs a single check. The buffer has a single
+ * writer and needs no locks, it must be read by the same thread or after the writer stops
+ */
+class CProfiler
+{
+public:
+    /**
+     * @brief Records the time spent in a scope
+     */
+    class CZone
+    {
+    public:
+        /**
+         * @brief Starts the zone, when a profiler is attached to the thread
+         * 
+         * @param name the name of the zone, must outlive the profiler (a string literal)
+         */
+        CZone(const char * name);
+
+        CZone(const CZone & orig) = delete;
+        CZone & operator = (const CZone & orig) = delete;
+
+        /**
+         * @brief Ends the zone and records it
+         */
+        ~CZone();
+
+    private:
+        CProfiler * profiler;   /**< The profiler of the thread, nullptr when nothing is recorded */
+        const char * name;      /**< The name of the zone */
+        int64_t start;          /**< When the zone started */
+    };
+
+    /**
+     * @brief CProfiler constructor
+     * 
+     * @param traceFile the trace written by save(), the captured slow frames are written next to it
+     * @param captureFrames the number of frames captured before and after a slow frame
+     */
+    CProfiler(const std::string & traceFile, const uint32_t & captureFrames = 30);
+
+    CProfiler(const CProfiler & orig) = delete;
+    CProfiler & operator = (const CProfiler & orig) = delete;
+
+    /**
+     * @brief Detaches the profiler, if it is still attached
+     */
+    ~CProfiler();
+
+    /**
+     * @brief Starts recording the zones of the calling thread
+     */
+    void attach();
+
+    /**
+     * @brief Stops recording the zones of the calling thread
+     */
+    void detach();
+
+    /**
+     * @brief Marks the start of a frame
+     */
+    void beginFrame();
+
+    /**
+     * @brief Marks the end of a frame
+     * 
+     * A frame longer than frameDelay gets captured together with the frames around it,
+     * once the frames after it are recorded. Only one capture is made at a time
+     * 
+     * @warning Throws FileException, when the capture can't be written
+     */
+    void endFrame();
+
+    /**
+     * @brief Writes everything still kept in the buffer into the trace file
+     * 
+     * @warning Throws FileException, when the file can't be written
+     */
+    void save() const;
+
+private:
+    /**
+     * @brief One finished zone
+     */
+    struct SRecord
+    {
+        const char * name;  /**< The name of the zone */
+        int64_t start;      /**< The start in nanoseconds */
+        int64_t end;        /**< The end in nanoseconds */
+        uint32_t frame;     /**< The frame the zone belongs to */
+    };
+
+    static constexpr uint64_t capacity = 1 << 14;       /**< The number of records kept, a power of two */
+    static thread_local CProfiler * active;             /**< The profiler attached to the thread */
+
+    std::unique_ptr<SRecord[]> records;                 /**< The ring buffer */
+    std::atomic<uint64_t> head;                         /**< The number of records written so far */
+    std::string traceFile;                              /**< Where the whole buffer is saved */
+    uint32_t captureFrames;                             /**< The frames captured around a slow one */
+    uint32_t frame;                                     /**< The number of the current frame */
+    int64_t frameStart;                                 /**< When the current frame started */
+    uint32_t slowFrame;                                 /**< The slow frame waiting to be captured */
+    bool capturing;                                     /**< A slow frame is waiting to be captured */
+
+    /**
+     * @brief Returns the current time in nanoseconds
+     */
+    static int64_t now();
+
+    /**
+     * @brief Adds a record into the buffer, overwriting the oldest one when full
+     * 
+     * @param record the record
+     */
+    void push(const SRecord & record);
+
+    /**
+     * @brief Writes the records of the chosen frames as a Chrome trace
+     * 
+     * @param filePath the file
+     * @param from the first frame written
+     * @param to the last frame written
+     * @warning Throws FileException, when the file can't be written
+     */
+    void write(const std::string & filePath, const uint32_t & from, const uint32_t & to) const;
+};
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <random>
+
+#include "CSnapshot.hpp"
+
+/**
+ * @brief A pseudorandom number generator owned by one game
+ * 
+ * Uses the xoshiro256** generator, which only needs 32 bytes of state and a few
+ * operations per number. Everything random in a game is drawn from its generator,
+ * so the same seed always produces the same maps and the same enemy movement,
+ * and games running side by side don't share anything
+ */
+class CRandom
+{
+public:
+    static const uint64_t maxSeed = INT_MAX;    /**< The largest seed, the configuration file accepts every seed up to it */
+
+    /**
+     * @brief CRandom constructor
+     * 
+     * @param seed the seed, 0 means a random one between 1 and maxSeed
+     */
+    CRandom(const uint64_t & seed = 0);
+
+    /**
+     * @brief Starts the sequence of numbers again from a seed
+     * 
+     * @param seed the seed, 0 means a random one between 1 and maxSeed
+     */
+    void seed(const uint64_t & seed);
+
+    /**
+     * @brief Returns the seed the current sequence started from
+     * 
+     * @return the seed
+     */
+    uint64_t getSeed() const;
+
+    /**
+     * @brief Returns the next 64 random bits
+     * 
+     * @return the random bits
+     */
+    uint64_t next();
+
+    /**
+     * @brief Returns a random integer in a given closed interval
+     * 
+     * Every integer of the interval has the same chance
+     * 
+     * @param from begin of the interval
+     * @param to end of the interval
+     * @return the integer
+     */
+    int between(const int & from, const int & to);
+
+    /**
+     * @brief Writes the state of the generator into a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void save(CSnapshot & snapshot) const;
+
+    /**
+     * @brief Reads the state of the generator from a snapshot
+     * 
+     * The sequence then continues exactly where it was, when the snapshot was taken
+     * 
+     * @param snapshot the snapshot
+     */
+    void load(CSnapshot & snapshot);
+
+private:
+    uint64_t state[4];      /**< The state of the generator */
+    uint64_t seedValue;     /**< The seed the current sequence started from */
+};
\ No newline at end of file
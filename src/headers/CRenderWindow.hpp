@@ -4,14 +4,23 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 #include <map>
 #include <memory>
+#include <vector>
+#include <array>
+#include <tuple>
+#include <chrono>
 
 #include "GameConstants.hpp"
 #include "ETileType.hpp"
 #include "ETextType.hpp"
 #include "EUIType.hpp"
+#include "ERenderLayer.hpp"
+#include "CTileGrid.hpp"
+#include "CThreadPool.hpp"
+#include "CAssetPack.hpp"
 
 /**
  * @brief Class that takes care of all the rendering logic 
@@ -37,21 +46,140 @@ public:
      */
     ~CRenderWindow();
 
+    /**
+     * @brief How long starting the rendering took
+     */
+    struct SStartupTimes
+    {
+        double decode = 0;  /**< Milliseconds spent decoding the images and rasterising the fonts */
+        double upload = 0;  /**< Milliseconds spent creating the textures */
+        bool fromPack = false;  /**< The assets were read from the asset pack */
+    };
+
     /**
      * @brief Opens a window on screen and starts rendering
+     * 
+     * The textures are created straight from the asset pack, when there is one
+     * built from the current assets. Otherwise the images are decoded and the fonts rasterised by worker threads,
+     * only the textures are created on the calling thread, which owns the renderer
+     * 
+     * @warning Throws an error if any of the assets could not be loaded
      */
     void startRender();
 
+    /**
+     * @brief Decodes all of the assets and writes them into an asset pack
+     * 
+     * Doesn't need a window, only the SDL_image and SDL_ttf libraries
+     * 
+     * @param filePath the path to the pack
+     * @warning Throws an error if any of the assets could not be loaded or the pack written
+     */
+    static void buildAssetPack(const std::string & filePath);
+
+    /**
+     * @brief Returns how long starting the rendering took
+     * 
+     * @return the times of the phases of startRender()
+     */
+    SStartupTimes getStartupTimes() const;
+
     /**
      * @brief Clears the buffer of the renderer
      */
     void clear();
 
     /**
-     * @brief Displays the rendered content on screen
+     * @brief Draws everything waiting in the render queue and displays the rendered content on screen
      */
     void display();
 
+    /**
+     * @brief Draws the following sprites into a part of the window
+     * 
+     * Everything queued so far is drawn first. The following sprites are then moved,
+     * so the shown part of the map lands in the part of the window, and clipped to it
+     * 
+     * @param world the part of the map shown, in map pixels
+     * @param screen the part of the window it is shown in, of the same size
+     */
+    void setView(const SDL_Rect & world, const SDL_Rect & screen);
+
+    /**
+     * @brief Draws the following sprites over the whole window again, as they are
+     * 
+     * Everything queued so far is drawn first
+     */
+    void resetView();
+
+    /**
+     * @brief Collects the sprites drawn during a frame and draws them in batches
+     * 
+     * The sprites are sorted into their layers as they come, a layer keeps the order
+     * in which its sprites came. The sprites are then drawn layer by layer, the neighbouring
+     * sprites sharing a texture are drawn together in one SDL_RenderGeometry call.
+     * The memory is kept between frames, so drawing doesn't allocate anything
+     */
+    class CRenderQueue
+    {
+    public:
+        /**
+         * @brief CRenderQueue constructor
+         */
+        CRenderQueue();
+
+        /**
+         * @brief Adds a sprite to be drawn
+         * 
+         * @param texture the texture with the sprite
+         * @param layer the layer to draw the sprite in
+         * @param source the part of the texture with the sprite, in texture coordinates (0 to 1)
+         * @param target the position and size of the sprite on screen
+         */
+        void push(SDL_Texture * texture, const ERenderLayer & layer, const SDL_FRect & source, const SDL_Rect & target);
+
+        /**
+         * @brief Moves all of the following sprites by an offset
+         * 
+         * @param origin the offset
+         */
+        void setOrigin(const SDL_Point & origin);
+
+        /**
+         * @brief Returns the offset the sprites are moved by
+         * 
+         * @return the offset
+         */
+        SDL_Point getOrigin() const;
+
+        /**
+         * @brief Draws all of the sprites waiting in the queue and empties it
+         */
+        void flush();
+
+    private:
+        /**
+         * @brief A sprite waiting to be drawn
+         */
+        struct SSprite
+        {
+            SDL_Texture * texture;      /**< The texture with the sprite */
+            SDL_Vertex vertices[4];     /**< The corners of the sprite */
+        };
+
+        std::array<std::vector<SSprite>, ERenderLayer_MAX + 1> layers;  /**< The sprites sorted into the layers */
+        std::vector<SDL_Vertex> vertices;                               /**< The vertices of the current batch */
+        std::vector<int> indices;                                       /**< Two triangles for each sprite of the batch */
+        SDL_Point origin;                                               /**< The offset the sprites are moved by */
+
+        /**
+         * @brief Draws the current batch
+         * 
+         * @param texture the texture shared by the sprites of the batch
+         */
+        void submit(SDL_Texture * texture);
+    };
+
     /**
      * @brief A class that holds renderable textures for the objects
      * 
@@ -73,11 +201,24 @@ public:
         /**
          * @brief CTexture constructor
          * 
-         * @param filePath the file path to the image
+         * @param image the decoded image, the texture doesn't take it over
          * @param w width of the image
          * @param h height of the image
+         * @param layer the layer to render the texture in
+         * @warning Throws an error if the texture could not be created
          */
-        CTexture(const char * filePath, const int & w, const int & h);
+        CTexture(SDL_Surface * image, const int & w, const int & h, const ERenderLayer & layer = LAYER_UI);
+
+        /**
+         * @brief CTexture constructor for a sprite packed in an atlas
+         * 
+         * The texture doesn't own the atlas
+         * 
+         * @param atlas the texture with all of the sprites
+         * @param region the part of the atlas with the sprite
+         * @param layer the layer to render the sprite in
+         */
+        CTexture(SDL_Texture * atlas, const SDL_Rect & region, const ERenderLayer & layer);
 
         CTexture(const CTexture & original) = delete;
         CTexture operator = (const CTexture & original) = delete;
@@ -85,6 +226,8 @@ public:
         /**
          * @brief Renders the texture on screen
          * 
+         * The texture is only put into the render queue, it gets drawn with the rest of its layer
+         * 
          * @param srcX x position of the source image
          * @param srcY y position of the source image
          * @param tarX x position of the target image
@@ -99,10 +242,18 @@ public:
 
     private:
         SDL_Texture * texture;      /**< The loaded texture */
+        SDL_Rect region;            /**< The part of the texture with the image */
+        int textureWidth;           /**< Width of the whole texture */
+        int textureHeight;          /**< Height of the whole texture */
+        ERenderLayer layer;         /**< The layer to render the texture in */
     };
 
     /**
-     * @brief A class that manages renderable text textures
+     * @brief A font of one colour, which renders any text without creating textures
+     * 
+     * All of the printable ASCII characters are rasterised once into a glyph atlas.
+     * A text is then drawn character by character from the atlas, the characters share
+     * the texture, so the render queue draws them in one batch
      */
     class CText
     {
@@ -112,43 +263,126 @@ public:
          */
         CText();
 
+        static constexpr char firstGlyph = ' ';     /**< The first character in the atlas */
+        static constexpr char lastGlyph = '~';      /**< The last character in the atlas */
+
+        using TGlyphs = std::array<SDL_FRect, lastGlyph - firstGlyph + 1>;
+
         /**
          * @brief CText constructor
          * 
-         * @param filePath the file path to the font
+         * @param atlasSurface the glyph atlas rasterised by rasterise(), the text doesn't take it over
+         * @param glyphs the part of the atlas with each character
+         * @warning Throws an error if the glyph atlas texture could not be created
+         */
+        CText(SDL_Surface * atlasSurface, const TGlyphs & glyphs);
+
+        /**
+         * @brief Rasterises the printable characters of a font into a glyph atlas
+         * 
+         * Doesn't need the renderer, so it can run on any thread,
+         * though one font must not be used by two threads at once
+         * 
+         * @param font the font
          * @param color color of the rendered text
-         * @param size size of the font
+         * @param glyphs gets the part of the atlas with each character, in texture coordinates
+         * @return the atlas, owned by the caller
+         * @warning Throws an error if the atlas could not be created
          */
-        CText(const char * filePath, const SDL_Color & color, const int & size);
+        static SDL_Surface * rasterise(TTF_Font * font, const SDL_Color & color, TGlyphs & glyphs);
 
         CText(const CText & original) = delete;
         CText operator = (const CText & original) = delete;
 
         /**
-         * @brief Create a new text texture in case the rendered text needs to change
+         * @brief Render the text
          * 
-         * @param text the text to be rendered
-         */
-        void renderNew(const std::string & text);
-
-        /**
-         * @brief Render the text texture
+         * The characters outside of the printable ASCII are left blank
          * 
          * @param text the text to be rendered
          * @param position the position on the screen
          * @param width the width of a letter
          * @param height the height of the text
          */
-        void render(const std::string & text, const std::pair<int,int> & position,
-                    const int & width = tileWidth / 2, const int & height = tileWidth);
+        void render(std::string_view text, const std::pair<int,int> & position,
+                    const int & width = tileWidth / 2, const int & height = tileWidth) const;
 
         friend class CRenderWindow;
 
     private:
-        TTF_Font * font;            /**< The font of the text */
-        SDL_Color color;            /**< The color of the text */
-        SDL_Texture * textTexture;  /**< The texture of the text */
-        std::string oldText;        /**< The message that is currently rendered */
+        SDL_Texture * atlas;    /**< The characters rasterised next to each other */
+        TGlyphs glyphs;         /**< The part of the atlas with each character, in texture coordinates */
+    };
+
+    /**
+     * @brief The tiles of the map drawn once into a texture
+     * 
+     * The walls never change and the breakables only change when they get destroyed,
+     * so the tiles are drawn into a texture, which is copied on screen in one go.
+     * Only the tiles, which have changed since the last frame, are drawn again
+     */
+    class CBackground
+    {
+    public:
+        /**
+         * @brief CBackground constructor
+         * 
+         * Without a texture to render into, or when the map is larger than the renderer's
+         * largest texture, the tiles on screen are drawn straight on it every frame
+         * 
+         * @param width the width of the map in tiles
+         * @param height the height of the map in tiles
+         */
+        CBackground(const int & width, const int & height);
+
+        CBackground(const CBackground & original) = delete;
+        CBackground operator = (const CBackground & original) = delete;
+
+        /**
+         * @brief CBackground destructor
+         */
+        ~CBackground();
+
+        /**
+         * @brief Marks all of the tiles to be drawn again, ex.: on a new map
+         */
+        void invalidate();
+
+        /**
+         * @brief Marks one tile to be drawn again
+         * 
+         * @param x x coordinate in tiles
+         * @param y y coordinate in tiles
+         */
+        void invalidate(const int & x, const int & y);
+
+        /**
+         * @brief Checks, whether the background was made for a map of these dimensions
+         * 
+         * @param width the width of the map in tiles
+         * @param height the height of the map in tiles
+         * @return true - the dimensions match
+         * @return false - otherwise
+         */
+        bool fits(const int & width, const int & height) const;
+
+        /**
+         * @brief Draws the changed tiles into the texture and queues the part of it in the view to be drawn on screen
+         * 
+         * @param tiles the tiles of the map
+         * @param textures the textures of the tiles, indexed by their type
+         * @param view the part of the map shown, in map pixels
+         */
+        void render(const CTileGrid & tiles,
+                    const std::array<std::shared_ptr<CTexture>, BREAKABLE + 1> & textures,
+                    const SDL_Rect & view);
+
+    private:
+        SDL_Texture * texture;                      /**< The tiles drawn together */
+        int width;                                  /**< The width of the texture in pixels */
+        int height;                                 /**< The height of the texture in pixels */
+        bool redrawAll;                             /**< All of the tiles need to be drawn */
+        std::vector<std::pair<int, int>> dirty;     /**< The tiles, which changed since the last frame */
     };
 
     /**
@@ -180,17 +414,77 @@ public:
 private:
     SDL_Window * window;                                  /**< Stores the created window */
     static SDL_Renderer * renderer;                       /**< Stores the rendering context for the window*/
+    static CRenderQueue queue;                            /**< The sprites waiting to be drawn in the current frame */
+    SDL_Texture * atlas;                                  /**< All of the tile textures packed together */
     std::map<ETileType, std::shared_ptr<CTexture>> tiles; /**< Stores tile textures */
     std::map<ETextType, std::shared_ptr<CText>> text;     /**< Stores text textures */
     std::map<EUIType, std::shared_ptr<CTexture>> UI;      /**< Stores UI textures */
+    SStartupTimes startupTimes;                           /**< How long startRender() took */
+
+    /**
+     * @brief The assets decoded by the worker threads, waiting to become textures
+     */
+    struct SDecodedAssets
+    {
+        std::vector<SDL_Surface *> sprites;         /**< The tile sprites, in the order of the atlas */
+        std::vector<SDL_Surface *> UI;              /**< The images of the UI */
+        std::vector<SDL_Surface *> texts;           /**< The glyph atlas of each text */
+        std::vector<CText::TGlyphs> glyphs;         /**< The characters in the glyph atlas of each text */
+        std::vector<std::string> errors;            /**< The error of each task, empty when it succeeded */
+
+        /**
+         * @brief Frees all of the surfaces
+         */
+        ~SDecodedAssets();
+
+        /**
+         * @brief Frees all of the surfaces and forgets them
+         */
+        void clear();
+    };
 
     /**
-     * @brief Loads in the needed textures
+     * @brief Reads the assets from an asset pack
+     * 
+     * The surfaces point into the pack, it must outlive them
+     * 
+     * @param pack the asset pack
+     * @param assets the read assets
+     * @warning Throws FileException if the pack misses any of the assets
      */
-    void loadTextures();
+    static void readAssetPack(const CAssetPack & pack, SDecodedAssets & assets);
 
     /**
-     * @brief Loads in the needed text textures
+     * @brief Returns the fingerprint of the image and font files, from which the assets get decoded
+     * 
+     * @return the fingerprint, see CAssetPack::fingerprint()
+     */
+    static uint64_t assetSources();
+
+    /**
+     * @brief Decodes the images and rasterises the fonts on worker threads
+     * 
+     * Every task writes only its own part of the assets. The font is opened once
+     * and all of the texts are rasterised from it by one task, the font must not be shared
+     * 
+     * @param assets the decoded assets
+     * @warning Throws an error if any of the tasks failed
+     */
+    static void decodeAssets(SDecodedAssets & assets);
+
+    /**
+     * @brief Creates the needed textures
+     * 
+     * The tile textures are packed into one atlas, so the sprites can be drawn together
+     * 
+     * @param assets the decoded images
+     */
+    void loadTextures(const SDecodedAssets & assets);
+
+    /**
+     * @brief Creates the needed text textures
+     * 
+     * @param assets the rasterised glyph atlases
      */
-    void loadTexts();
+    void loadTexts(const SDecodedAssets & assets);
 };
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "CObjectEventManager.hpp"
+#include "CConfig.hpp"
+#include "CSnapshot.hpp"
+#include "CInput.hpp"
+
+/**
+ * @brief Records the input of a game, so it can be played again exactly the same way
+ * 
+ * The game is fully determined by its starting state and the input of the players
+ * in each time frame. A replay holds the configuration, a snapshot of the game when
+ * the recording started and the inputs. The inputs rarely change between time frames,
+ * so they are stored as runs of the same input. The replay also remembers the hash
+ * of the final state, a game played back from it must end in the very same state
+ */
+class CReplay
+{
+public:
+    static constexpr uint32_t magic = 0x50524d42;   /**< "BMRP" at the beginning of every replay file */
+    static constexpr uint16_t version = 2;          /**< Increased whenever the layout of the file changes */
+
+    /**
+     * @brief Starts recording a game
+     * 
+     * @param manager the game, it must have started already
+     * @param config the configuration of the game
+     */
+    void begin(const CObjectEventManager & manager, const CConfig & config);
+
+    /**
+     * @brief Records the input of the next time frame
+     * 
+     * @param input the input of both players
+     */
+    void record(const SInputFrame & input);
+
+    /**
+     * @brief Finishes the recording and remembers the final state of the game
+     * 
+     * @param manager the game
+     */
+    void end(const CObjectEventManager & manager);
+
+    /**
+     * @brief Puts a game into the state in which the recording started
+     * 
+     * The configuration in memory is replaced with the recorded one
+     * 
+     * @param manager the game
+     * @param config the configuration the manager was constructed with
+     * @warning Throws an invalid_argument when the replay is corrupted
+     */
+    void play(CObjectEventManager & manager, CConfig & config);
+
+    /**
+     * @brief Returns the input of the next time frame during playback
+     * 
+     * @param input where to write the input
+     * @return true - the input was written
+     * @return false - the replay has ended
+     */
+    bool next(SInputFrame & input);
+
+    /**
+     * @brief Checks, whether the game ended in the same state as the recorded one
+     * 
+     * @param manager the game that was played back
+     * @return true - the states are identical
+     * @return false - the game diverged
+     */
+    bool check(const CObjectEventManager & manager) const;
+
+    /**
+     * @brief Returns the number of recorded time frames
+     * 
+     * @return the number of time frames
+     */
+    uint32_t getTicks() const;
+
+    /**
+     * @brief Writes the replay into a file
+     * 
+     * @param filePath the path to the file
+     * @warning Throws a FileException when the file can't be written
+     */
+    void save(const std::string & filePath) const;
+
+    /**
+     * @brief Reads a replay from a file
+     * 
+     * @param filePath the path to the file
+     * @warning Throws a FileException when the file can't be read
+     * and an invalid_argument when it is not a replay
+     */
+    void load(const std::string & filePath);
+
+private:
+    /**
+     * @brief The same input repeated for a number of time frames
+     */
+    struct SRun
+    {
+        SInputFrame input;      /**< The input */
+        uint16_t length;        /**< The number of time frames */
+    };
+
+    CSnapshot settings;         /**< The numerical items of the configuration */
+    CSnapshot start;            /**< The state of the game when the recording started */
+    std::vector<SRun> runs;     /**< The inputs in the order of the time frames */
+    uint32_t ticks = 0;         /**< The number of recorded time frames */
+    uint64_t finalHash = 0;     /**< The hash of the snapshot of the game after the last time frame */
+    size_t run = 0;             /**< The current run during playback */
+    uint16_t played = 0;        /**< The number of time frames played from the current run */
+    mutable CSnapshot scratch;  /**< Memory for the snapshots needed to compute the hashes */
+};
\ No newline at end of file
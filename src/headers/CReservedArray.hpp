@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+/**
+ * @brief A contiguous array of objects of one kind with the memory reserved in advance
+ * 
+ * The new objects go at the end, removed objects are closed up by the owner, so the array
+ * stays without gaps. Once it is reserved for the busiest moment of the game, creating and
+ * removing the objects doesn't allocate any memory. It still grows past the reserved size,
+ * then all of the objects move to new addresses - the high-water mark tells how many
+ * objects it had to hold at most, so the reserved size can be set right
+ */
+template <typename T>
+class CReservedArray
+{
+public:
+    /**
+     * @brief CReservedArray constructor
+     * 
+     * @param capacity the number of objects, for which the memory is reserved in advance
+     */
+    CReservedArray(const size_t & capacity = 0);
+
+    /**
+     * @brief Reserves the memory for at least the given number of objects
+     * 
+     * @param capacity the number of objects
+     */
+    void reserve(const size_t & capacity);
+
+    /**
+     * @brief Constructs a new object at the end of the array
+     * 
+     * When the reserved memory is full, the array grows and the objects move
+     * 
+     * @param args the arguments of the object's constructor
+     * @return the new object
+     */
+    template <typename ... Args>
+    T & emplace_back(Args && ... args);
+
+    /**
+     * @brief Removes the objects from first to last, they must be at the end of the array
+     * 
+     * @param first the first object to remove
+     * @param last the object after the last one to remove
+     */
+    void erase(typename std::vector<T>::iterator first, typename std::vector<T>::iterator last);
+
+    /**
+     * @brief Removes all of the objects, the memory is kept
+     */
+    void clear();
+
+    /**
+     * @brief Returns the largest number of objects that were in the array at once
+     * 
+     * @return the high-water mark
+     */
+    size_t highWaterMark() const;
+
+    size_t size() const;
+    size_t capacity() const;
+    bool empty() const;
+    T & back();
+    T & operator [] (const size_t & i);
+    const T & operator [] (const size_t & i) const;
+    typename std::vector<T>::iterator begin();
+    typename std::vector<T>::iterator end();
+    typename std::vector<T>::const_iterator begin() const;
+    typename std::vector<T>::const_iterator end() const;
+
+private:
+    std::vector<T> objects;     /**< The objects, the memory behind them is reserved for the next ones */
+    size_t highWater;           /**< The largest number of objects so far */
+};
+
+template <typename T>
+CReservedArray<T>::CReservedArray(const size_t & capacity)
+: highWater(0)
+{
+    this->objects.reserve(capacity);
+}
+
+template <typename T>
+void CReservedArray<T>::reserve(const size_t & capacity)
+{
+    this->objects.reserve(capacity);
+}
+
+template <typename T>
+template <typename ... Args>
+T & CReservedArray<T>::emplace_back(Args && ... args)
+{
+    this->objects.emplace_back(std::forward<Args>(args)...);
+    this->highWater = std::max(this->highWater, this->objects.size());
+    return this->objects.back();
+}
+
+template <typename T>
+void CReservedArray<T>::erase(typename std::vector<T>::iterator first, typename std::vector<T>::iterator last)
+{
+    this->objects.erase(first, last);
+}
+
+template <typename T>
+void CReservedArray<T>::clear() { this->objects.clear(); }
+
+template <typename T>
+size_t CReservedArray<T>::highWaterMark() const { return this->highWater; }
+
+template <typename T>
+size_t CReservedArray<T>::size() const { return this->objects.size(); }
+
+template <typename T>
+size_t CReservedArray<T>::capacity() const { return this->objects.capacity(); }
+
+template <typename T>
+bool CReservedArray<T>::empty() const { return this->objects.empty(); }
+
+template <typename T>
+T & CReservedArray<T>::back() { return this->objects.back(); }
+
+template <typename T>
+T & CReservedArray<T>::operator [] (const size_t & i) { return this->objects[i]; }
+
+template <typename T>
+const T & CReservedArray<T>::operator [] (const size_t & i) const { return this->objects[i]; }
+
+template <typename T>
+typename std::vector<T>::iterator CReservedArray<T>::begin() { return this->objects.begin(); }
+
+template <typename T>
+typename std::vector<T>::iterator CReservedArray<T>::end() { return this->objects.end(); }
+
+template <typename T>
+typename std::vector<T>::const_iterator CReservedArray<T>::begin() const { return this->objects.begin(); }
+
+template <typename T>
+typename std::vector<T>::const_iterator CReservedArray<T>::end() const { return this->objects.end(); }
\ No newline at end of file
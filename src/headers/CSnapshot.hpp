@@ -0,0 +1,154 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Exceptions.hpp"
+
+/**
+ * @brief A compact binary image of the whole state of a game
+ * 
+ * The values are written one after another as raw bytes, in the byte order of the machine,
+ * behind a short header with a magic number and the version of the format.
+ * Taking a snapshot and restoring it only copies bytes, so it is fast enough to be done
+ * every time frame - for quicksaves, crash recovery or trying out what would happen.
+ * The memory is kept between snapshots, so taking another one doesn't allocate anything.
+ * Other binary files of the game, like replays, are written the same way with their own magic number
+ */
+class CSnapshot
+{
+public:
+    static constexpr uint32_t magic = 0x53534d42;   /**< "BMSS" at the beginning of every snapshot */
+    static constexpr uint16_t version = 2;          /**< Increased whenever the layout of the data changes */
+
+    /**
+     * @brief Removes the data and writes the header of a new snapshot
+     * 
+     * @param formatMagic the magic number of the format
+     * @param formatVersion the version of the format
+     */
+    void begin(const uint32_t & formatMagic = magic, const uint16_t & formatVersion = version);
+
+    /**
+     * @brief Starts reading the data from the beginning and checks the header
+     * 
+     * @param formatMagic the expected magic number of the format
+     * @param formatVersion the expected version of the format
+     * @warning Throws an invalid_argument when the data is not of this format and version
+     */
+    void rewind(const uint32_t & formatMagic = magic, const uint16_t & formatVersion = version);
+
+    /**
+     * @brief Appends a value
+     * 
+     * @param value the value, it must be trivially copyable
+     */
+    template <typename T>
+    void write(const T & value);
+
+    /**
+     * @brief Reads the next value
+     * 
+     * @return the value
+     * @warning Throws an invalid_argument when the snapshot ends too early
+     */
+    template <typename T>
+    T read();
+
+    /**
+     * @brief Appends an array of bytes
+     * 
+     * @param data the bytes
+     * @param size the number of bytes
+     */
+    void writeBytes(const void * data, const size_t & size);
+
+    /**
+     * @brief Reads the next array of bytes
+     * 
+     * @param data where to copy the bytes
+     * @param size the number of bytes
+     * @warning Throws an invalid_argument when the snapshot ends too early
+     */
+    void readBytes(void * data, const size_t & size);
+
+    /**
+     * @brief Appends all of the data of another snapshot, preceded by its size
+     * 
+     * @param other the other snapshot
+     */
+    void writeSnapshot(const CSnapshot & other);
+
+    /**
+     * @brief Reads another snapshot written by writeSnapshot()
+     * 
+     * @param other where to read the other snapshot, its data is replaced
+     * @warning Throws an invalid_argument when the snapshot ends too early
+     */
+    void readSnapshot(CSnapshot & other);
+
+    /**
+     * @brief Computes a 64-bit FNV-1a hash of the data
+     * 
+     * Two games in the same state have snapshots with the same hash
+     * 
+     * @return the hash
+     */
+    uint64_t hash() const;
+
+    /**
+     * @brief Checks, whether all of the data has been read
+     * 
+     * @return true - nothing is left to read
+     * @return false - otherwise
+     */
+    bool finished() const;
+
+    /**
+     * @brief Writes the snapshot into a file
+     * 
+     * @param filePath the path to the file
+     * @warning Throws a FileException when the file can't be written
+     */
+    void save(const std::string & filePath) const;
+
+    /**
+     * @brief Reads a snapshot from a file
+     * 
+     * @param filePath the path to the file
+     * @warning Throws a FileException when the file can't be read
+     */
+    void load(const std::string & filePath);
+
+    /**
+     * @brief Returns the raw data of the snapshot
+     * 
+     * @return the bytes
+     */
+    const std::vector<uint8_t> & getData() const;
+
+private:
+    std::vector<uint8_t> data;  /**< The bytes of the snapshot */
+    size_t offset = 0;          /**< The position of the next value to read */
+};
+
+template <typename T>
+void CSnapshot::write(const T & value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written into a snapshot");
+    writeBytes(&value, sizeof(T));
+}
+
+template <typename T>
+T CSnapshot::read()
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read from a snapshot");
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+}
\ No newline at end of file
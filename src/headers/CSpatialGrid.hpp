@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <SDL2/SDL.h>
+
+#include "GameConstants.hpp"
+
+class CObject;
+
+/**
+ * @brief A uniform grid of the map tiles holding the objects standing on them
+ * 
+ * Every object is registered in all of the tiles its collision box overlaps.
+ * Collision queries then only need to check the objects in the few tiles
+ * around the collision box instead of all the objects on the map
+ */
+class CSpatialGrid
+{
+public:
+    /**
+     * @brief CSpatialGrid constructor
+     * 
+     * @param width the width of the map in tiles
+     * @param height the height of the map in tiles
+     */
+    CSpatialGrid(const int & width = 0, const int & height = 0);
+
+    /**
+     * @brief Removes all of the objects and resizes the grid
+     * 
+     * @param width the width of the map in tiles
+     * @param height the height of the map in tiles
+     */
+    void reset(const int & width, const int & height);
+
+    /**
+     * @brief Registers the object in the tiles overlapped by its collision box
+     * 
+     * @param obj the object
+     */
+    void insert(CObject * obj);
+
+    /**
+     * @brief Unregisters the object from all of its tiles
+     * 
+     * @param obj the object
+     */
+    void remove(CObject * obj);
+
+    /**
+     * @brief Moves the object into the tiles its collision box overlaps now
+     * 
+     * Does nothing, when the object didn't move to other tiles
+     * 
+     * @param obj the object
+     */
+    void move(CObject * obj);
+
+    /**
+     * @brief Replaces an object, which moved in memory, with its new address
+     * 
+     * The object must stay in the same tiles
+     * 
+     * @param from the old address of the object
+     * @param to the new address of the object
+     */
+    void relocate(const CObject * from, CObject * to);
+
+    /**
+     * @brief Returns the range of tiles overlapped by a box
+     * 
+     * The range is clamped to the map
+     * 
+     * @param box the box in screen coordinates
+     * @return the first tile in x and y, the number of tiles in w and h
+     */
+    SDL_Rect cells(const SDL_Rect & box) const;
+
+    /**
+     * @brief Returns the objects registered in a tile
+     * 
+     * @param x x position of the tile
+     * @param y y position of the tile
+     * @return the objects
+     */
+    const std::vector<CObject *> & at(const int & x, const int & y) const;
+
+private:
+    int width;                                  /**< The width of the map in tiles */
+    int height;                                 /**< The height of the map in tiles */
+    std::vector<std::vector<CObject *>> grid;   /**< The objects in each tile, stored row by row */
+
+    /**
+     * @brief Removes the object from the tiles in the given range
+     * 
+     * @param obj the object
+     * @param range the range of tiles
+     */
+    void erase(CObject * obj, const SDL_Rect & range);
+
+    /**
+     * @brief Adds the object into the tiles in the given range
+     * 
+     * @param obj the object
+     * @param range the range of tiles
+     */
+    void add(CObject * obj, const SDL_Rect & range);
+};
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief A fixed-size queue between one producer thread and one consumer thread
+ * 
+ * Needs no locks: only the producer moves the tail and only the consumer moves the head,
+ * each of them publishes its move with a release store, which the other one reads with
+ * an acquire load. Pushing into a full queue fails instead of waiting, so the producer never blocks
+ */
+template <typename T, size_t Capacity>
+class CSpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two");
+
+public:
+    CSpscQueue();
+
+    CSpscQueue(const CSpscQueue & orig) = delete;
+    CSpscQueue & operator = (const CSpscQueue & orig) = delete;
+
+    /**
+     * @brief Adds an item at the end, called only by the producer
+     * 
+     * @param item the item
+     * @return true - the item was added
+     * @return false - the queue is full, the item was dropped
+     */
+    bool push(const T & item);
+
+    /**
+     * @brief Returns the first item without removing it, called only by the consumer
+     * 
+     * @param item gets the first item
+     * @return true - there was an item
+     * @return false - the queue is empty
+     */
+    bool front(T & item) const;
+
+    /**
+     * @brief Removes the first item, called only by the consumer after front() found one
+     */
+    void pop();
+
+private:
+    std::array<T, Capacity> items;          /**< The items, indexed by the counters modulo the capacity */
+    alignas(64) std::atomic<size_t> head;   /**< The number of items popped, moved by the consumer */
+    alignas(64) std::atomic<size_t> tail;   /**< The number of items pushed, moved by the producer */
+};
+
+template <typename T, size_t Capacity>
+CSpscQueue<T, Capacity>::CSpscQueue()
+: items(),
+  head(0),
+  tail(0)
+{}
+
+template <typename T, size_t Capacity>
+bool CSpscQueue<T, Capacity>::push(const T & item)
+{
+    size_t tail = this->tail.load(std::memory_order_relaxed);
+    if (tail - this->head.load(std::memory_order_acquire) == Capacity)
+        return false;
+
+    this->items[tail & (Capacity - 1)] = item;
+    this->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, size_t Capacity>
+bool CSpscQueue<T, Capacity>::front(T & item) const
+{
+    size_t head = this->head.load(std::memory_order_relaxed);
+    if (head == this->tail.load(std::memory_order_acquire))
+        return false;
+
+    item = this->items[head & (Capacity - 1)];
+    return true;
+}
+
+template <typename T, size_t Capacity>
+void CSpscQueue<T, Capacity>::pop()
+{
+    this->head.store(this->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
\ No newline at end of file
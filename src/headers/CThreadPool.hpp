@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+/**
+ * @brief A fixed number of worker threads carrying out tasks from a shared queue
+ * 
+ * The threads are started once and wait for the tasks, so a task only costs
+ * taking it from the queue. The tasks must not share any state, unless they
+ * synchronize it themselves
+ */
+class CThreadPool
+{
+public:
+    /**
+     * @brief Starts the worker threads
+     * 
+     * @param threads the number of threads, 0 means one for each core
+     */
+    CThreadPool(const size_t & threads = 0);
+
+    CThreadPool(const CThreadPool & orig) = delete;
+    CThreadPool & operator = (const CThreadPool & orig) = delete;
+
+    /**
+     * @brief Waits for the remaining tasks and stops the threads
+     */
+    ~CThreadPool();
+
+    /**
+     * @brief Adds a task to the queue, one of the threads will carry it out
+     * 
+     * @param task the task
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Waits until all of the submitted tasks are finished
+     */
+    void wait();
+
+    /**
+     * @brief Returns the number of worker threads
+     * 
+     * @return the number of threads
+     */
+    size_t size() const;
+
+private:
+    std::vector<std::thread> workers;           /**< The worker threads */
+    std::queue<std::function<void()>> tasks;    /**< The tasks waiting for a thread */
+    std::mutex mutex;                           /**< Guards the queue and the counters */
+    std::condition_variable taskReady;          /**< Wakes the workers up, when a task comes or the pool stops */
+    std::condition_variable allDone;            /**< Wakes wait() up, when the last task finishes */
+    size_t running;                             /**< The number of tasks being carried out */
+    bool stopping;                              /**< The pool is being destroyed */
+
+    /**
+     * @brief The loop of a worker thread - takes tasks from the queue until the pool stops
+     */
+    void work();
+};
\ No newline at end of file
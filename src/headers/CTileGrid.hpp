@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <SDL2/SDL.h>
+
+#include "ETileType.hpp"
+#include "GameConstants.hpp"
+#include "CSnapshot.hpp"
+
+/**
+ * @brief The tiles of the game map - walls, breakables and empty grass tiles
+ * 
+ * The tiles don't have any behaviour, so each of them is just one byte
+ * holding its type, stored row by row in one contiguous array.
+ * The collision boxes and the positions on the screen are computed from
+ * the coordinates when needed
+ */
+class CTileGrid
+{
+public:
+    /**
+     * @brief CTileGrid constructor
+     * 
+     * @param width the width of the map in tiles
+     * @param height the height of the map in tiles
+     */
+    CTileGrid(const int & width = 0, const int & height = 0);
+
+    /**
+     * @brief Resizes the grid and fills it with empty tiles
+     * 
+     * @param width the width of the map in tiles
+     * @param height the height of the map in tiles
+     */
+    void reset(const int & width, const int & height);
+
+    /**
+     * @brief Returns the type of a tile
+     * 
+     * @param x x coordinate in tiles
+     * @param y y coordinate in tiles
+     * @return the tile type
+     */
+    ETileType at(const int & x, const int & y) const;
+
+    /**
+     * @brief Sets the type of a tile
+     * 
+     * @param x x coordinate in tiles
+     * @param y y coordinate in tiles
+     * @param tileType the new tile type
+     */
+    void set(const int & x, const int & y, const ETileType & tileType);
+
+    /**
+     * @brief Checks whether the objects can't walk through a tile
+     * 
+     * @param x x coordinate in tiles
+     * @param y y coordinate in tiles
+     * @return true - the tile is a wall or a breakable
+     * @return false - otherwise
+     */
+    bool isSolid(const int & x, const int & y) const;
+
+    /**
+     * @brief Returns the range of tiles overlapped by a box, clamped to the map
+     * 
+     * @param box the box in screen coordinates
+     * @return the first tile in x and y, and the number of tiles in w and h
+     */
+    SDL_Rect cells(const SDL_Rect & box) const;
+
+    /**
+     * @brief Returns the collision box of a tile
+     * 
+     * @param x x coordinate in tiles
+     * @param y y coordinate in tiles
+     * @return the box in screen coordinates
+     */
+    static SDL_Rect box(const int & x, const int & y);
+
+    /**
+     * @brief Writes the dimensions and all of the tiles into a snapshot
+     * 
+     * @param snapshot the snapshot
+     */
+    void save(CSnapshot & snapshot) const;
+
+    /**
+     * @brief Reads the dimensions and all of the tiles from a snapshot
+     * 
+     * @param snapshot the snapshot
+     * @warning Throws an invalid_argument when the dimensions are out of range or a tile is unknown
+     */
+    void load(CSnapshot & snapshot);
+
+    int getWidth() const;
+    int getHeight() const;
+
+private:
+    int width;                      /**< The width of the map in tiles */
+    int height;                     /**< The height of the map in tiles */
+    std::vector<uint8_t> tiles;     /**< The tile types row by row */
+};
\ No newline at end of file
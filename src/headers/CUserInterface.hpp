@@ -2,10 +2,12 @@
 
 #include <list>
 #include <memory>
+#include <string>
 
 #include "CButton.hpp"
 #include "CRenderWindow.hpp"
 #include "Utilities.hpp"
+#include "CConfig.hpp"
 
 /**
  * @brief Takes care of the user interface in main menu
@@ -17,8 +19,9 @@ public:
      * @brief CUserInterface constructor
      * 
      * @param renderer pointer to the rendering logic - needed for loading the textures
+     * @param config the configuration of the game - holds the high score
      */
-    CUserInterface(const CRenderWindow * renderer);
+    CUserInterface(const CRenderWindow * renderer, const CConfig & config);
 
     /**
      * @brief Handles button presses
@@ -38,9 +41,16 @@ public:
      */
     void show();
 
+    /**
+     * @brief Hide the UI
+     */
+    void hide();
+
 private:
     int shown;                                              /**< Flag which controls rendering */
     int highScore;                                          /**< The current high score */
+    std::string highScoreLabel;                             /**< The high score formatted once, when it changes */
+    const CConfig & config;                                 /**< The configuration of the game */
     double scalar;                                          /**< Scales the UI according to the size of the window */
     std::shared_ptr<CRenderWindow::CText> highScoreText;    /**< The text texture of the high score */
     std::list<std::unique_ptr<CButton>> buttons;            /**< The UI components */
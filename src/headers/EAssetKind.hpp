@@ -0,0 +1,11 @@
+#pragma once
+
+/**
+ * @brief Kinds of the assets stored in the asset pack
+ */
+enum EAssetKind
+{
+    ASSET_SPRITE,
+    ASSET_UI,
+    ASSET_TEXT
+};
\ No newline at end of file
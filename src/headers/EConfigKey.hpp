@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * @brief The items of the configuration file
+ * 
+ * @note EConfigKey_MAX holds the number of different items
+ */
+enum EConfigKey
+{
+    CONFIG_HIGH_SCORE,
+    CONFIG_SAVE_FILE,
+    CONFIG_MAP_WIDTH,
+    CONFIG_MAP_HEIGHT,
+    CONFIG_ENEMIES,
+    CONFIG_ENEMY_CHASE,
+    CONFIG_BREAKABLES,
+    CONFIG_DUEL_ROUNDS,
+    CONFIG_BONUS_CHANCE,
+    CONFIG_BONUS_MEGA_BOMBS,
+    CONFIG_BONUS_SPEED,
+    CONFIG_POOL_BOMBS,
+    CONFIG_POOL_EXPLOSIONS,
+    CONFIG_POOL_BONUSES,
+    CONFIG_SEED,
+    EConfigKey_MAX = CONFIG_SEED
+};
\ No newline at end of file
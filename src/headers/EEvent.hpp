@@ -2,6 +2,8 @@
 
 /**
  * @brief All various events types
+ * 
+ * @note EEvent_MAX holds the last event type
  */
 enum EEvent
 {
@@ -13,4 +15,5 @@ enum EEvent
     ENEMY_DEAD,
     POINTS,
     PLAYER_DEAD,
+    EEvent_MAX = PLAYER_DEAD
 };
\ No newline at end of file
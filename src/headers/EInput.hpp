@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief The actions of a player, each one is a bit of the player's input in a time frame
+ */
+enum EInput : uint8_t
+{
+    INPUT_UP    = 1 << 0,
+    INPUT_DOWN  = 1 << 1,
+    INPUT_LEFT  = 1 << 2,
+    INPUT_RIGHT = 1 << 3,
+    INPUT_BOMB  = 1 << 4
+};
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+/**
+ * @brief The layers of the rendered frame, from the bottom to the top
+ * 
+ * @note ERenderLayer_MAX holds the number of different layers
+ */
+enum ERenderLayer
+{
+    LAYER_TILES,
+    LAYER_ITEMS,
+    LAYER_BOMBS,
+    LAYER_EXPLOSIONS,
+    LAYER_CHARACTERS,
+    LAYER_UI,
+    LAYER_TEXT,
+    ERenderLayer_MAX = LAYER_TEXT
+};
\ No newline at end of file
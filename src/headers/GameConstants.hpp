@@ -11,6 +11,9 @@ const char * const config = "./examples/config.txt";
 const char * const config = "./examples/config-test.txt";
 #endif
 
+// Path to the pre-decoded assets built by 'make pack', without it the assets get decoded at startup
+const char * const assetPack = "./assets/assets.pack";
+
 // Screen dimensions
 const int screenWidth   = 2208;
 const int screenHeight  = 1440;
@@ -18,20 +21,23 @@ const int screenHeight  = 1440;
 // Tile width on screen
 const int tileWidth     = 96;
 
-// Game speed
-const int FPS           = 60;
+// Game speed - the game logic runs in fixed time frames (ticks), independently on the display
+const int tickRate      = 60;
+const double tickDelay  = 1000.0 / tickRate;
+
+// Display speed - the maximum of rendered frames per second
+const int FPS           = 120;
 const int frameDelay    = 1000 / FPS;
 
-// Map dimensions
-const int mapWidth      = (screenWidth / tileWidth) % 2 == 0 ? screenWidth / tileWidth - 1 : screenWidth / tileWidth;
-const int mapHeight     = (screenHeight / tileWidth) % 2 == 0 ? screenHeight / tileWidth - 1 : screenHeight / tileWidth;
+// The maximum of rendered frames skipped in a row, when the game logic falls behind
+const int maxFrameSkip  = 5;
+
+// The map dimensions are read from the configuration file, independently on the screen
+const int maxMapSize    = 1001;
 
 // Entity characteristics
-const int playerSpeed   = (tileWidth / 32) / ((double)FPS / 60) + 1;
-const int enemySpeed    = (tileWidth / 32) / ((double)FPS / 60);
+const int playerSpeed   = (tileWidth / 32) / ((double)tickRate / 60) + 1;
+const int enemySpeed    = (tileWidth / 32) / ((double)tickRate / 60);
 
 // Defines for the classes to shorten the code
-#define Events  std::list<std::tuple<EEvent, std::pair<int, int>, int, CObject *>>
-#define Event   std::tuple<EEvent, std::pair<int, int>, int, CObject *>
-#define TileSet std::vector<std::vector<std::unique_ptr<CTile>>>
 #define Map     std::vector<std::vector<ETileType>>
\ No newline at end of file
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <random>
 #include <fstream>
 #include <sstream>
 #include <tuple>
@@ -8,15 +7,6 @@
 
 #include "Exceptions.hpp"
 
-/**
- * @brief Retruns a random integer in a given closed interval
- * 
- * @param from begin of the interval
- * @param to end of the interval
- * @return the integer
- */
-int randomInt(const int & from, const int & to);
-
 /**
  * @brief Trims the leading and ending cahracters from a string
  * 
@@ -0,0 +1,177 @@
+#include "CAssetPack.hpp"
+
+CAssetPack::CAssetPack(const std::string & filePath)
+: data(nullptr),
+  size(0)
+{
+    using namespace std;
+
+    int file = open(filePath.c_str(), O_RDONLY);
+    if (file < 0)
+        throw FileException("The asset pack "s.append(filePath).append(" could not be opened"));
+
+    struct stat info;
+    if (fstat(file, &info) < 0 || info.st_size < (off_t)sizeof(SHeader))
+    {
+        close(file);
+        throw FileException("The asset pack "s.append(filePath).append(" is too short"));
+    }
+
+    // The mapping stays valid after the file gets closed
+    void * mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED)
+        throw FileException("The asset pack "s.append(filePath).append(" could not be mapped"));
+
+    this->data = (const uint8_t *)mapping;
+    this->size = info.st_size;
+
+    // Check everything the index points to lies within the pack, so reading the assets can't go past it
+    const SHeader * header = (const SHeader *)this->data;
+    bool valid = memcmp(header->magic, magic, sizeof(magic)) == 0 && header->version == version
+              && header->count <= (this->size - sizeof(SHeader)) / sizeof(SEntry);
+
+    const SEntry * entries = (const SEntry *)(this->data + sizeof(SHeader));
+    for (uint32_t i = 0; valid && i < header->count; ++ i)
+    {
+        const SEntry & entry = entries[i];
+        uint64_t pixelBytes = (uint64_t)entry.width * entry.height * 4;
+        uint64_t glyphBytes = (uint64_t)entry.glyphCount * sizeof(SDL_FRect);
+        valid = entry.width <= INT32_MAX / 4 && entry.height <= INT32_MAX
+             && entry.pixels % alignment == 0 && entry.glyphs % alignment == 0
+             && entry.pixels <= this->size && pixelBytes <= this->size - entry.pixels
+             && entry.glyphs <= this->size && glyphBytes <= this->size - entry.glyphs;
+    }
+
+    if (! valid)
+    {
+        munmap(mapping, this->size);
+        throw FileException("The asset pack "s.append(filePath).append(" is damaged or of another version"));
+    }
+}
+
+CAssetPack::~CAssetPack()
+{
+    munmap((void *)this->data, this->size);
+}
+
+SDL_Surface * CAssetPack::image(const EAssetKind & kind, const int & id) const
+{
+    using namespace std;
+
+    const SEntry & entry = this->find(kind, id);
+
+    // The mapping is read only, SDL only reads the pixels of a surface it doesn't own
+    SDL_Surface * surface = SDL_CreateRGBSurfaceWithFormatFrom((void *)(this->data + entry.pixels), entry.width, entry.height,
+                                                               32, entry.width * 4, SDL_PIXELFORMAT_RGBA32);
+    if (! surface)
+        throw FileException("The asset could not be read from the pack: "s.append(SDL_GetError()));
+    return surface;
+}
+
+std::vector<SDL_FRect> CAssetPack::glyphs(const EAssetKind & kind, const int & id) const
+{
+    const SEntry & entry = this->find(kind, id);
+    const SDL_FRect * first = (const SDL_FRect *)(this->data + entry.glyphs);
+    return std::vector<SDL_FRect>(first, first + entry.glyphCount);
+}
+
+uint64_t CAssetPack::getSources() const
+{
+    return ((const SHeader *)this->data)->sources;
+}
+
+const CAssetPack::SEntry & CAssetPack::find(const EAssetKind & kind, const int & id) const
+{
+    using namespace std;
+
+    const SHeader * header = (const SHeader *)this->data;
+    const SEntry * entries = (const SEntry *)(this->data + sizeof(SHeader));
+    for (uint32_t i = 0; i < header->count; ++ i)
+        if (entries[i].kind == (uint32_t)kind && entries[i].id == (uint32_t)id)
+            return entries[i];
+
+    throw FileException("The asset pack doesn't contain the asset "s.append(to_string(kind)).append("/").append(to_string(id)));
+}
+
+void CAssetPack::write(const std::string & filePath, const std::vector<SAsset> & assets, const uint64_t & sources)
+{
+    using namespace std;
+
+    auto align = [](uint64_t offset) { return (offset + alignment - 1) / alignment * alignment; };
+
+    // Lay the assets out behind the index, each of them aligned
+    vector<SEntry> entries;
+    uint64_t offset = align(sizeof(SHeader) + assets.size() * sizeof(SEntry));
+    for (auto & asset : assets)
+    {
+        SEntry entry = {};
+        entry.kind = asset.kind;
+        entry.id = asset.id;
+        entry.width = asset.image->w;
+        entry.height = asset.image->h;
+        entry.pixels = offset;
+        offset = align(offset + (uint64_t)entry.width * entry.height * 4);
+        entry.glyphs = offset;
+        entry.glyphCount = asset.glyphs.size();
+        offset = align(offset + asset.glyphs.size() * sizeof(SDL_FRect));
+        entries.push_back(entry);
+    }
+
+    vector<uint8_t> pack(offset, 0);
+    SHeader header = {};
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.count = entries.size();
+    header.sources = sources;
+    memcpy(pack.data(), &header, sizeof(header));
+    memcpy(pack.data() + sizeof(SHeader), entries.data(), entries.size() * sizeof(SEntry));
+
+    for (size_t i = 0; i < assets.size(); ++ i)
+    {
+        SDL_Surface * image = assets[i].image;
+        bool converted = image->format->format != SDL_PIXELFORMAT_RGBA32;
+        if (converted)
+            image = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+        if (! image)
+            throw FileException("The asset could not be converted: "s.append(SDL_GetError()));
+
+        // Copy the rows one by one, the surface may pad them
+        SDL_LockSurface(image);
+        for (int row = 0; row < image->h; ++ row)
+            memcpy(pack.data() + entries[i].pixels + (uint64_t)row * image->w * 4,
+                   (const uint8_t *)image->pixels + (uint64_t)row * image->pitch, image->w * 4);
+        SDL_UnlockSurface(image);
+
+        if (converted)
+            SDL_FreeSurface(image);
+
+        memcpy(pack.data() + entries[i].glyphs, assets[i].glyphs.data(), assets[i].glyphs.size() * sizeof(SDL_FRect));
+    }
+
+    ofstream file(filePath, ios::binary | ios::trunc);
+    if (! file.write((const char *)pack.data(), pack.size()))
+        throw FileException("The asset pack "s.append(filePath).append(" could not be written"));
+}
+
+uint64_t CAssetPack::fingerprint(const std::vector<std::string> & filePaths)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+
+    for (auto & filePath : filePaths)
+    {
+        struct stat info = {};
+        stat(filePath.c_str(), &info);
+
+        // The nanoseconds tell apart the files rewritten within one second
+        uint64_t parts[] = {(uint64_t)info.st_size, (uint64_t)info.st_mtim.tv_sec, (uint64_t)info.st_mtim.tv_nsec};
+        for (auto part : parts)
+            for (int i = 0; i < 8; ++ i)
+            {
+                hash ^= (part >> (i * 8)) & 0xff;
+                hash *= 0x100000001b3;
+            }
+    }
+
+    return hash;
+}
\ No newline at end of file
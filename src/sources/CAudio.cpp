@@ -0,0 +1,110 @@
+#include "CAudio.hpp"
+
+CAudio::CAudio()
+{
+    using namespace std;
+
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
+        throw runtime_error("SDL audio initialization error: "s.append(SDL_GetError()));
+
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, bufferSamples) < 0)
+    {
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        throw runtime_error("SDL audio initialization error: "s.append(Mix_GetError()));
+    }
+
+    // The device may change the frequency and the channels, the samples are synthesised to fit
+    if (! Mix_QuerySpec(&frequency, &format, &channels) || format != AUDIO_S16SYS)
+    {
+        this->close();
+        throw runtime_error("SDL audio initialization error: The audio device doesn't play 16-bit samples");
+    }
+
+    // The sound of each event, chosen by ear
+    const STone tones[] = {
+        {PLACE_BOMB,      440,  660, 0.06, 0,   0.4},
+        {PLACE_EXPLOSION, 120,   40, 0.40, 0.8, 0.7},
+        {GET_BONUS,       500, 1200, 0.15, 0,   0.4},
+        {DOOR_REACHED,    300,  900, 0.35, 0,   0.5},
+        {PLAYER_DEAD,     600,  150, 0.50, 0.2, 0.6}
+    };
+
+    // A fixed pool of channels, one for each sound
+    Mix_AllocateChannels(size(tones));
+    this->sounds.reserve(size(tones));
+    for (auto & tone : tones)
+    {
+        this->sounds.push_back(SSound{tone.event, synthesise(tone, frequency, channels), nullptr, 0});
+        SSound & sound = this->sounds.back();
+        sound.chunk = Mix_QuickLoad_RAW((Uint8 *)sound.samples.data(), sound.samples.size() * sizeof(int16_t));
+        if (! sound.chunk)
+        {
+            this->close();
+            throw runtime_error("SDL audio initialization error: "s.append(Mix_GetError()));
+        }
+    }
+}
+
+CAudio::~CAudio()
+{
+    this->close();
+}
+
+void CAudio::close()
+{
+    // The chunks must not play, once they are freed
+    Mix_HaltChannel(-1);
+    for (auto & sound : this->sounds)
+        if (sound.chunk)
+            Mix_FreeChunk(sound.chunk);
+    this->sounds.clear();
+
+    Mix_CloseAudio();
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+void CAudio::play(const uint32_t & events)
+{
+    if (! events)
+        return;
+
+    Uint32 now = SDL_GetTicks();
+    for (size_t i = 0; i < this->sounds.size(); ++ i)
+    {
+        SSound & sound = this->sounds[i];
+        if (! (events & (1u << sound.event)) || (sound.started && now - sound.started < restartDelay))
+            continue;
+
+        Mix_PlayChannel(i, sound.chunk, 0);
+        sound.started = now;
+    }
+}
+
+std::vector<int16_t> CAudio::synthesise(const STone & tone, const int & frequency, const int & channels)
+{
+    using namespace std;
+
+    // The noise is always the same, nothing to do with the random number generator of the game
+    minstd_rand noise(1);
+    uniform_real_distribution<double> sample(-1, 1);
+
+    size_t length = tone.duration * frequency;
+    vector<int16_t> samples(length * channels);
+    double phase = 0;
+    for (size_t i = 0; i < length; ++ i)
+    {
+        double progress = (double)i / length;
+        phase += 2 * M_PI * (tone.from + (tone.to - tone.from) * progress) / frequency;
+
+        // A square wave fading out, with a short fade in to avoid a click
+        double square = sin(phase) >= 0 ? 1 : -1;
+        double envelope = min(1.0, i / (0.005 * frequency)) * (1 - progress) * (1 - progress);
+        double value = ((1 - tone.noise) * square + tone.noise * sample(noise)) * envelope * tone.volume;
+
+        for (int channel = 0; channel < channels; ++ channel)
+            samples[i * channels + channel] = value * INT16_MAX;
+    }
+    return samples;
+}
\ No newline at end of file
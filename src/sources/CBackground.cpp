@@ -0,0 +1,98 @@
+#include "CRenderWindow.hpp"
+
+CRenderWindow::CBackground::CBackground(const int & width, const int & height)
+: texture(nullptr),
+  width(width * tileWidth),
+  height(height * tileWidth),
+  redrawAll(true)
+{
+    this->dirty.reserve(std::min(width * height, 1024));
+
+    // The whole map must fit into one texture
+    SDL_RendererInfo info;
+    if (! renderer || SDL_GetRendererInfo(renderer, &info) != 0
+     || (info.max_texture_width && this->width > info.max_texture_width)
+     || (info.max_texture_height && this->height > info.max_texture_height)
+     || ! this->width || ! this->height)
+        return;
+
+    if (SDL_RenderTargetSupported(renderer))
+        this->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                          this->width, this->height);
+}
+
+CRenderWindow::CBackground::~CBackground()
+{
+    if (this->texture)
+        SDL_DestroyTexture(this->texture);
+}
+
+void CRenderWindow::CBackground::invalidate()
+{
+    this->redrawAll = true;
+    this->dirty.clear();
+}
+
+bool CRenderWindow::CBackground::fits(const int & width, const int & height) const
+{
+    return this->width == width * tileWidth && this->height == height * tileWidth;
+}
+
+void CRenderWindow::CBackground::invalidate(const int & x, const int & y)
+{
+    if (! this->redrawAll)
+        this->dirty.emplace_back(x, y);
+}
+
+void CRenderWindow::CBackground::render(const CTileGrid & tiles,
+                                        const std::array<std::shared_ptr<CTexture>, BREAKABLE + 1> & textures,
+                                        const SDL_Rect & view)
+{
+    auto draw = [&] (const int & x, const int & y)
+    {
+        textures[tiles.at(x, y)]->render(0, 0, x * tileWidth, y * tileWidth, tileWidth, tileWidth);
+    };
+
+    // There is no texture, queue the tiles in the view to be drawn straight on screen
+    if (! this->texture)
+    {
+        SDL_Rect range = tiles.cells(view);
+        for (int y = range.y; y < range.y + range.h; ++ y)
+            for (int x = range.x; x < range.x + range.w; ++ x)
+                draw(x, y);
+        return;
+    }
+
+    // Bring the texture up to date
+    if (this->redrawAll || ! this->dirty.empty())
+    {
+        // Whatever was queued so far belongs on screen, not into the texture,
+        // the tiles are drawn into it where they are on the map
+        queue.flush();
+        SDL_SetRenderTarget(renderer, this->texture);
+        SDL_Point origin = queue.getOrigin();
+        queue.setOrigin({0, 0});
+
+        if (this->redrawAll)
+        {
+            for (int y = 0; y < tiles.getHeight(); ++ y)
+                for (int x = 0; x < tiles.getWidth(); ++ x)
+                    draw(x, y);
+        }
+        else
+            for (auto & tile : this->dirty)
+                draw(tile.first, tile.second);
+
+        queue.flush();
+        SDL_SetRenderTarget(renderer, nullptr);
+        queue.setOrigin(origin);
+        this->redrawAll = false;
+        this->dirty.clear();
+    }
+
+    // Only the part of the texture in the view gets copied
+    SDL_Rect whole = {0, 0, this->width, this->height}, shown;
+    if (SDL_IntersectRect(&view, &whole, &shown))
+        queue.push(this->texture, LAYER_TILES, {(float)shown.x / this->width, (float)shown.y / this->height,
+                                                (float)shown.w / this->width, (float)shown.h / this->height}, shown);
+}
\ No newline at end of file
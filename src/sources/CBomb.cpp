@@ -6,13 +6,13 @@ CBomb::CBomb(const std::pair<int, int> & position, const ETileType & tile,
 : CObject(position, tile, texture),
   hasExploded(false),
   shown(true),
-  ticks(FPS * 2),
+  ticks(tickRate * 2),
   boomSize(explosionSize)
 {}
 
-void CBomb::update(Events & events,
-                   const TileSet & tileSet,
-                   const std::list<std::shared_ptr<CObject>> & objects)
+void CBomb::update(CEventQueue & events,
+                   const CTileGrid & tileSet,
+                   const CSpatialGrid & grid)
 {
     this->ticks --;
 
@@ -20,18 +20,41 @@ void CBomb::update(Events & events,
         this->hasExploded = true;
     
     // The bomb stops rendering for one time frame - it looks like it is ticking
-    if (this->ticks % (FPS / 2) == 0)
+    if (this->ticks % (tickRate / 2) == 0)
         this-> shown = false;
     else
         this->shown = true;
 
+    createEvents(events, tileSet, grid);
+}
+
+int CBomb::getSize() const { return this->boomSize; }
+
+void CBomb::render(const double & alpha) const
+{
     if (this->shown)
-        render();
+        CObject::render(alpha);
+}
 
-    createEvents(events, tileSet, objects);
+void CBomb::save(CSnapshot & snapshot) const
+{
+    CObject::save(snapshot);
+    snapshot.write(this->hasExploded);
+    snapshot.write(this->shown);
+    snapshot.write(this->ticks);
+    snapshot.write(this->boomSize);
+}
+
+void CBomb::load(CSnapshot & snapshot)
+{
+    CObject::load(snapshot);
+    this->hasExploded = snapshot.read<bool>();
+    this->shown = snapshot.read<bool>();
+    this->ticks = snapshot.read<int>();
+    this->boomSize = snapshot.read<int>();
 }
 
-void CBomb::createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CBomb::createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
     using std::make_pair;
 
@@ -50,34 +73,34 @@ void CBomb::createEvents(Events & events, const TileSet & tileSet, const std::li
     int maxY = y + boomSize;
 
     // Update the coordinates when a wall is in the way
-    if (tileSet[y][x - 1]->tileType == WALL)
+    if (tileSet.at(x - 1, y) == WALL)
         iX = x;
-    if (tileSet[y][x + 1]->tileType == WALL)
+    if (tileSet.at(x + 1, y) == WALL)
         maxX = x;
-    if (tileSet[y - 1][x]->tileType == WALL)
+    if (tileSet.at(x, y - 1) == WALL)
         iY = y;
-    if (tileSet[y + 1][x]->tileType == WALL)
+    if (tileSet.at(x, y + 1) == WALL)
         maxY = y;
 
     // Set explosion on X axis
     for (; iX <= maxX; ++ iX)
     {
         // Ensure that it does not try to read values out of the map
-        if (iX < 0 || iX > mapWidth)
+        if (iX < 0 || iX > tileSet.getWidth() - 1)
             continue;
 
-        if (tileSet[y][iX]->tileType != WALL)
-            events.emplace_back(PLACE_EXPLOSION, make_pair(iX, deScale(this->position.second)), 0, nullptr);
+        if (tileSet.at(iX, y) != WALL)
+            events.push(PLACE_EXPLOSION, SPlaceExplosion{make_pair(iX, deScale(this->position.second))});
     }
     // Set explosion on Y axis (not considering the centre of explosion)
     for (; iY <= maxY; ++ iY)
     {
         // Ensure that it does not try to read values out of the map
-        if (iY < 0 || iY > mapHeight - 1)
+        if (iY < 0 || iY > tileSet.getHeight() - 1)
             continue;
 
-        if (tileSet[iY][x]->tileType != WALL)
-            events.emplace_back(PLACE_EXPLOSION, make_pair(deScale(this->position.first), iY), 0, nullptr);
+        if (tileSet.at(x, iY) != WALL)
+            events.push(PLACE_EXPLOSION, SPlaceExplosion{make_pair(deScale(this->position.first), iY)});
     }
 
     this->toRemove = true;
@@ -1,44 +1,39 @@
 #include "CBonus.hpp"
 
 CBonus::CBonus(const std::pair<int, int> & position, const ETileType & tile,
-               const std::shared_ptr<CRenderWindow::CTexture> & texture)
-: CObject(position, tile, texture)
+               const std::shared_ptr<CRenderWindow::CTexture> & texture, CRandom & random, const CConfig & config)
+: CObject(position, tile, texture),
+  random(&random),
+  config(&config)
 {
-    if (this->bonuses.empty())
-    {
-        this->bonuses.emplace(MEGABOMBS, loadData(config, "Bonus mega bombs"));
-        this->bonuses.emplace(SPEED, loadData(config, "Bonus speed"));
-    }
     setCollisionBox();
 }
 
-void CBonus::update(Events & events,
-                    const TileSet & tileSet,
-                    const std::list<std::shared_ptr<CObject>> & objects)
+void CBonus::update(CEventQueue & events,
+                    const CTileGrid & tileSet,
+                    const CSpatialGrid & grid)
 {
-    render();
-
-    if (objectCollision(objects, PLAYER1) || objectCollision(objects, PLAYER2))
+    if (objectCollision(grid, PLAYER1) || objectCollision(grid, PLAYER2))
     {
         this->toRemove = true;
-        createEvents(events, tileSet, objects);
+        createEvents(events, tileSet, grid);
     }
 }
 
-void CBonus::createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CBonus::createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
     using std::make_pair;
 
     // Randomly chooses from the bonus types
-    auto it = this->bonuses.begin();
-    advance(it, randomInt(0, this->bonuses.size() - 1));
+    auto bonus = static_cast<EBonusType>(this->random->between(MEGABOMBS, SPEED));
+    int strength = this->config->get(bonus == MEGABOMBS ? CONFIG_BONUS_MEGA_BOMBS : CONFIG_BONUS_SPEED);
 
-    auto collidingObj = objectCollision(objects, PLAYER1);
-    if (collidingObj)
-        events.emplace_back(GET_BONUS, make_pair(it->first, it->second), 0, collidingObj);
+    // The player is identified by its tile type, the objects can move in memory
+    auto collidingObj = objectCollision(grid, PLAYER1);
+    if (! collidingObj)
+        collidingObj = objectCollision(grid, PLAYER2);
 
-    else
-        events.emplace_back(GET_BONUS, make_pair(it->first, it->second), 0, objectCollision(objects, PLAYER2));
+    events.push(GET_BONUS, SGetBonus{bonus, strength, collidingObj->getTile()});
 }
 
 std::pair<int,int> CBonus::getTilePos() const
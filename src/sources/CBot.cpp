@@ -0,0 +1,192 @@
+#include "CBot.hpp"
+
+CBot::CBot(const ETileType & player, const uint64_t & seed)
+: player(player),
+  random(seed),
+  pressedBomb(false),
+  lastPosition(std::make_pair(-1, -1)),
+  stuckFrames(0),
+  wander(0),
+  wanderFrames(0),
+  width(0)
+{}
+
+uint8_t CBot::think(const CObjectEventManager & manager)
+{
+    const CObjectStore & store = manager.getStore();
+    const CTileGrid & tiles = manager.getTiles();
+
+    const CPlayer * me = nullptr;
+    for (auto & player : store.players)
+        if (player.getTile() == this->player)
+            me = &player;
+
+    // The player is dead
+    if (! me)
+        return 0;
+
+    // The player walked into a corner it can't get around, try a random direction for a while
+    if (this->wanderFrames)
+    {
+        -- this->wanderFrames;
+        this->lastPosition = me->getPosition();
+        return this->wander;
+    }
+
+    look(manager);
+
+    auto [x, y] = me->getTilePos();
+    int here = y * this->width + x;
+    uint8_t input = 0;
+    int step = -1;
+
+    if (this->danger[here] & blast)
+    {
+        // Run to the nearest safe tile, through the blasts if there is no other way
+        step = search(tiles, here, nullptr, INT_MAX, [this] (const int & cell) { return ! this->danger[cell]; });
+    }
+    else
+    {
+        // The bomb explodes after tickRate * 2 time frames, there must be a safe tile close enough
+        int size = me->getBombSize();
+        int reach = tickRate * 2 / (tileWidth / me->getSpeed() + 1) - 1;
+
+        if (! this->pressedBomb && worthBombing(tiles, here, size))
+        {
+            this->planned = this->danger;
+            markBlast(tiles, this->planned, x, y, size);
+
+            if (search(tiles, here, &this->danger, reach, [this] (const int & cell) { return ! this->planned[cell]; }) != -1)
+                input |= INPUT_BOMB;
+        }
+
+        // Go to the door once there is one, otherwise to the nearest tile from which a bomb hits something
+        if (! store.doors.empty())
+        {
+            auto [doorX, doorY] = store.doors.front().getTilePos();
+            int door = doorY * this->width + doorX;
+            step = search(tiles, here, &this->danger, INT_MAX, [door] (const int & cell) { return cell == door; });
+        }
+        else
+            step = search(tiles, here, &this->danger, INT_MAX, [&] (const int & cell) { return worthBombing(tiles, cell, size); });
+    }
+
+    this->pressedBomb = input & INPUT_BOMB;
+
+    if (step != -1)
+        input |= steer(*me, here, step);
+
+    // Count the time frames in which the player wanted to move, but didn't
+    if ((input & ~INPUT_BOMB) && me->getPosition() == this->lastPosition)
+        ++ this->stuckFrames;
+    else
+        this->stuckFrames = 0;
+    this->lastPosition = me->getPosition();
+
+    if (this->stuckFrames > tickRate / 4)
+    {
+        const uint8_t directions[] = {INPUT_UP, INPUT_DOWN, INPUT_LEFT, INPUT_RIGHT};
+        this->wander = directions[this->random.between(0, 3)];
+        this->wanderFrames = tileWidth / me->getSpeed();
+        this->stuckFrames = 0;
+    }
+
+    return input;
+}
+
+void CBot::look(const CObjectEventManager & manager)
+{
+    const CObjectStore & store = manager.getStore();
+    const CTileGrid & tiles = manager.getTiles();
+
+    this->width = tiles.getWidth();
+    int size = this->width * tiles.getHeight();
+    this->danger.assign(size, 0);
+    this->targets.assign(size, 0);
+
+    for (auto & bomb : store.bombs)
+    {
+        auto [x, y] = bomb.getTilePos();
+        markBlast(tiles, this->danger, x, y, bomb.getSize());
+    }
+    for (auto & explosion : store.explosions)
+    {
+        auto [x, y] = explosion.getTilePos();
+        this->danger[y * this->width + x] |= blast;
+    }
+    for (auto & obj : store.enemies)
+    {
+        auto [x, y] = obj.getTilePos();
+        this->danger[y * this->width + x] |= enemy;
+        this->targets[y * this->width + x] = true;
+    }
+    for (auto & obj : store.players)
+    {
+        auto [x, y] = obj.getTilePos();
+        if (obj.getTile() != this->player)
+            this->targets[y * this->width + x] = true;
+    }
+    for (int y = 0; y < tiles.getHeight(); ++ y)
+        for (int x = 0; x < this->width; ++ x)
+            if (tiles.at(x, y) == BREAKABLE)
+                this->targets[y * this->width + x] = true;
+}
+
+void CBot::markBlast(const CTileGrid & tiles, std::vector<uint8_t> & grid, const int & x, const int & y, const int & size) const
+{
+    // An explosion doesn't spread in the direction of a wall right next to the bomb
+    int fromX = tiles.at(x - 1, y) == WALL ? x : x - size;
+    int toX = tiles.at(x + 1, y) == WALL ? x : x + size;
+    int fromY = tiles.at(x, y - 1) == WALL ? y : y - size;
+    int toY = tiles.at(x, y + 1) == WALL ? y : y + size;
+
+    for (int i = fromX; i <= toX; ++ i)
+        if (i >= 0 && i < this->width && tiles.at(i, y) != WALL)
+            grid[y * this->width + i] |= blast;
+
+    for (int i = fromY; i <= toY; ++ i)
+        if (i >= 0 && i < tiles.getHeight() && tiles.at(x, i) != WALL)
+            grid[i * this->width + x] |= blast;
+}
+
+bool CBot::worthBombing(const CTileGrid & tiles, const int & cell, const int & size)
+{
+    int x = cell % this->width;
+    int y = cell / this->width;
+
+    // Walk the same cross as markBlast(), but only look
+    int fromX = tiles.at(x - 1, y) == WALL ? x : x - size;
+    int toX = tiles.at(x + 1, y) == WALL ? x : x + size;
+    int fromY = tiles.at(x, y - 1) == WALL ? y : y - size;
+    int toY = tiles.at(x, y + 1) == WALL ? y : y + size;
+
+    for (int i = fromX; i <= toX; ++ i)
+        if (i >= 0 && i < this->width && tiles.at(i, y) != WALL && this->targets[y * this->width + i])
+            return true;
+
+    for (int i = fromY; i <= toY; ++ i)
+        if (i >= 0 && i < tiles.getHeight() && tiles.at(x, i) != WALL && this->targets[i * this->width + x])
+            return true;
+
+    return false;
+}
+
+uint8_t CBot::steer(const CPlayer & me, const int & from, const int & to) const
+{
+    auto [px, py] = me.getPosition();
+    int dx = (to % this->width) * tileWidth - px;
+    int dy = (to / this->width) * tileWidth - py;
+    int speed = me.getSpeed();
+
+    // Line up on the other axis first, then move along the way
+    bool vertical = to / this->width != from / this->width;
+
+    if (! vertical && std::abs(dy) >= speed)
+        return dy < 0 ? INPUT_UP : INPUT_DOWN;
+    if (std::abs(dx) >= speed)
+        return dx < 0 ? INPUT_LEFT : INPUT_RIGHT;
+    if (std::abs(dy) >= speed)
+        return dy < 0 ? INPUT_UP : INPUT_DOWN;
+
+    return 0;
+}
\ No newline at end of file
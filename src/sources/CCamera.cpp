@@ -0,0 +1,55 @@
+#include "CCamera.hpp"
+
+CCamera::CCamera(const int & width, const int & height)
+: width(width),
+  height(height),
+  views({SView{{0, 0, width, height}, {0, 0, width, height}}})
+{}
+
+void CCamera::follow(const std::vector<std::pair<int,int>> & targets, const int & mapWidth, const int & mapHeight)
+{
+    using namespace std;
+
+    if (targets.empty())
+        return;
+
+    this->views.clear();
+    SDL_Rect window = {0, 0, this->width, this->height};
+
+    if (targets.size() == 1)
+    {
+        this->views.push_back(centre(targets.front(), window, mapWidth, mapHeight));
+        return;
+    }
+
+    // The players share the window, while both of them stay a tile away from its edges
+    const auto & first = targets[0], & second = targets[1];
+    if (abs(first.first - second.first) <= this->width - 2 * tileWidth
+     && abs(first.second - second.second) <= this->height - 2 * tileWidth)
+    {
+        auto middle = make_pair((first.first + second.first) / 2, (first.second + second.second) / 2);
+        this->views.push_back(centre(middle, window, mapWidth, mapHeight));
+        return;
+    }
+
+    // Otherwise each of them gets a half of the window, the left one goes to the first player
+    SDL_Rect left = {0, 0, this->width / 2, this->height};
+    SDL_Rect right = {this->width / 2, 0, this->width - this->width / 2, this->height};
+    this->views.push_back(centre(first, left, mapWidth, mapHeight));
+    this->views.push_back(centre(second, right, mapWidth, mapHeight));
+}
+
+const std::vector<CCamera::SView> & CCamera::getViews() const { return this->views; }
+
+CCamera::SView CCamera::centre(const std::pair<int,int> & target, const SDL_Rect & screen, const int & mapWidth, const int & mapHeight)
+{
+    // Keeps one coordinate of the view inside of the map, or the map in the middle of the view
+    auto place = [] (const int & point, const int & size, const int & mapSize)
+    {
+        if (mapSize <= size)
+            return (mapSize - size) / 2;
+        return std::clamp(point - size / 2, 0, mapSize - size);
+    };
+
+    return SView{{place(target.first, screen.w, mapWidth), place(target.second, screen.h, mapHeight), screen.w, screen.h}, screen};
+}
\ No newline at end of file
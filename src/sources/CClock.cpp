@@ -0,0 +1,72 @@
+#include "CClock.hpp"
+
+CClock::CClock(const double & tickDelay, const int & maxFrameSkip, std::function<double()> now)
+: tickDelay(tickDelay),
+  maxFrameSkip(maxFrameSkip),
+  accumulator(0),
+  now(now),
+  lastFrame(this->now()),
+  frameTicks(SDL_GetTicks()),
+  ticks(0),
+  skippedFrames(0)
+{}
+
+void CClock::startFrame()
+{
+    double now = this->now();
+    this->accumulator += now - this->lastFrame;
+    this->lastFrame = now;
+    this->frameTicks = SDL_GetTicks();
+    this->ticks = 0;
+
+    // Don't try to catch up with more time frames than can be simulated while skipping frames
+    this->accumulator = std::min(this->accumulator, this->tickDelay * (this->maxFrameSkip + 1));
+}
+
+bool CClock::tick()
+{
+    // Simulating more time frames in one frame would only make the game fall behind even more
+    if (this->accumulator < this->tickDelay || this->ticks > this->maxFrameSkip)
+        return false;
+
+    this->accumulator -= this->tickDelay;
+    ++ this->ticks;
+    return true;
+}
+
+bool CClock::shouldRender()
+{
+    // The time frames took longer than the time they simulate, use the time for the next time frames instead
+    bool behind = this->ticks > 0 && this->now() - this->lastFrame > this->ticks * this->tickDelay;
+    if (behind && this->skippedFrames < this->maxFrameSkip)
+    {
+        ++ this->skippedFrames;
+        return false;
+    }
+
+    this->skippedFrames = 0;
+    return true;
+}
+
+double CClock::alpha() const
+{
+    return std::min(this->accumulator / this->tickDelay, 1.0);
+}
+
+Uint32 CClock::simulatedUntil() const
+{
+    // The accumulator holds the real time not simulated yet
+    return this->frameTicks - (Uint32)this->accumulator;
+}
+
+void CClock::reset()
+{
+    this->accumulator = 0;
+    this->lastFrame = this->now();
+    this->frameTicks = SDL_GetTicks();
+}
+
+double CClock::realTime()
+{
+    return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "CConfig.hpp"
+
+const std::array<CConfig::SItem, EConfigKey_MAX + 1> CConfig::schema = {{
+    {"High score",       false, 0, INT_MAX, "Negative high score"},
+    {"Save file",        true,  0, 0,       ""},
+    {"Map width",        false, 5, 1001,    "Invalid map width. Minimum: 5, maximum: 1001, must be odd"},
+    {"Map height",       false, 5, 1001,    "Invalid map height. Minimum: 5, maximum: 1001, must be odd"},
+    {"Enemies",          false, 0, 1000,    "Invalid number of enemies. Minimum: 0, maximum: 1000"},
+    {"Enemy chase",      false, 0, 1,       "Invalid enemy chase. 0 - the enemies walk at random, 1 - they chase the players"},
+    {"Breakables",       false, 0, 1000000, "Invalid number of breakables. Minimum: 0, maximum: 1000000"},
+    {"Duel rounds",      false, 1, 10,      "Invalid number of duel rounds. Minimum: 1, maximum: 10"},
+    {"Bonus chance",     false, 0, 100,     "Invalid bonus chance in percent. Minimum: 0, maximum: 100"},
+    {"Bonus mega bombs", false, 1, INT_MAX, "Invalid mega bombs bonus size. Minimum: 1"},
+    {"Bonus speed",      false, 0, INT_MAX, "Invalid speed bonus size. Minimum: 0"},
+    {"Pool bombs",       false, 1, 10000,   "Invalid object pool size under label Pool bombs. Minimum: 1, maximum: 10000"},
+    {"Pool explosions",  false, 1, 10000,   "Invalid object pool size under label Pool explosions. Minimum: 1, maximum: 10000"},
+    {"Pool bonuses",     false, 1, 10000,   "Invalid object pool size under label Pool bonuses. Minimum: 1, maximum: 10000"},
+    {"Seed",             false, 0, INT_MAX, "Invalid seed. Minimum: 0 (a random seed)"}
+}};
+
+CConfig::CConfig(const char * filePath)
+: filePath(filePath)
+{
+    using namespace std;
+
+    auto data = parse(filePath);
+
+    for (int key = 0; key <= EConfigKey_MAX; ++ key)
+    {
+        const SItem & item = this->schema[key];
+        auto found = data.find(toLower(item.label));
+
+        if (found == data.end())
+            throw FileException("The item "s.append(item.label).append(" was not found"));
+        if (found->second.empty())
+            throw FileException("No data found under label "s.append(item.label));
+
+        if (item.isText)
+        {
+            this->texts[key] = found->second;
+            continue;
+        }
+
+        // Exactly one number is expected
+        size_t length = 0;
+        try { this->values[key] = stoi(found->second, &length); }
+        catch (const logic_error & err) { length = 0; }
+
+        if (! length || length != found->second.size())
+            throw FileException("Expected one numerical value under label "s.append(item.label));
+
+        if (this->values[key] < item.min || this->values[key] > item.max)
+            throw invalid_argument(item.error);
+    }
+
+    checkMapSize();
+}
+
+int CConfig::get(const EConfigKey & key) const { return this->values[key]; }
+
+const std::string & CConfig::getText(const EConfigKey & key) const { return this->texts[key]; }
+
+void CConfig::set(const EConfigKey & key, const int & value)
+{
+    this->values[key] = value;
+    saveData(this->filePath.c_str(), this->schema[key].label, value);
+}
+
+void CConfig::save(CSnapshot & snapshot) const
+{
+    for (int key = 0; key <= EConfigKey_MAX; ++ key)
+        if (! this->schema[key].isText)
+            snapshot.write(this->values[key]);
+}
+
+void CConfig::load(CSnapshot & snapshot)
+{
+    for (int key = 0; key <= EConfigKey_MAX; ++ key)
+    {
+        if (this->schema[key].isText)
+            continue;
+
+        int value = snapshot.read<int>();
+        if (value < this->schema[key].min || value > this->schema[key].max)
+            throw std::invalid_argument(this->schema[key].error);
+
+        this->values[key] = value;
+    }
+
+    checkMapSize();
+}
+
+void CConfig::checkMapSize() const
+{
+    // The map is framed by walls and the pillars stand on the even tiles, so the last row and column must be odd
+    for (auto key : {CONFIG_MAP_WIDTH, CONFIG_MAP_HEIGHT})
+        if (this->values[key] % 2 == 0)
+            throw std::invalid_argument(this->schema[key].error);
+}
+
+std::map<std::string, std::string> CConfig::parse(const char * filePath)
+{
+    using namespace std;
+
+    ifstream in(filePath);
+    if (! in.is_open() || in.fail())
+        throw FileException("Failed to open the file");
+
+    map<string, string> data;
+    string * current = nullptr;     // The data under the last label
+    string line;
+
+    while (getline(in, line))
+    {
+        trim(line);
+        if (line.empty() && ! current)
+            continue;
+
+        // A new label begins
+        if (! line.empty() && isLabel(line))
+        {
+            trim(line, " \n\t\"");
+            current = &data[toLower(line)];
+            current->clear();
+            continue;
+        }
+
+        if (current)
+        {
+            if (! current->empty())
+                *current += "\n";
+            *current += line;
+        }
+    }
+
+    if (in.fail() && ! in.eof())
+        throw FileException("File could not be read");
+
+    // Blank lines at the end of the data don't belong to it
+    for (auto & item : data)
+        trim(item.second);
+
+    return data;
+}
\ No newline at end of file
@@ -5,14 +5,13 @@ CDoor::CDoor(const std::pair<int, int> & position, const ETileType & tile,
 : CObject(position, tile, texture)
 {}
 
-void CDoor::update(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CDoor::update(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
-    render();
-    createEvents(events, tileSet, objects);
+    createEvents(events, tileSet, grid);
 }
 
-void CDoor::createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CDoor::createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
-    if (objectCollision(objects, PLAYER1))
-        events.emplace_back(DOOR_REACHED, std::make_pair(0,0), 0, nullptr);
+    if (objectCollision(grid, PLAYER1))
+        events.push(DOOR_REACHED);
 }
\ No newline at end of file
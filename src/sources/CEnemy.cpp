@@ -1,30 +1,32 @@
 #include "CEnemy.hpp"
 
 CEnemy::CEnemy(const std::pair<int,int> & position, const ETileType & tile,
-               const std::shared_ptr<CRenderWindow::CTexture> & texture)
+               const std::shared_ptr<CRenderWindow::CTexture> & texture, CRandom & random,
+               const CFlowField * chase)
 : CObject(position, tile, texture),
-  availableDirections({STAY, UP, DOWN, LEFT, RIGHT})
+  availableDirections({STAY, UP, DOWN, LEFT, RIGHT}),
+  random(&random),
+  chase(chase)
 {
     setDirection();
 }
 
-void CEnemy::update(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CEnemy::update(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
-    render();
-    move(tileSet, objects);
-    createEvents(events, tileSet, objects);
+    move(tileSet, grid);
+    createEvents(events, tileSet, grid);
 }
 
-void CEnemy::createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CEnemy::createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
     using std::make_pair;
 
     // Enemy was caught in an explosion
-    if (objectCollision(objects, BOOM))
+    if (objectCollision(grid, BOOM))
     {
         this->toRemove = true;
-        events.emplace_back(POINTS, make_pair(0, 0), 100, nullptr);
-        events.emplace_back(ENEMY_DEAD, make_pair(0, 0), 0, nullptr);
+        events.push(POINTS, SPoints{100});
+        events.push(ENEMY_DEAD);
     }
 }
 
@@ -36,7 +38,36 @@ std::pair<int,int> CEnemy::getTilePos() const
     return std::make_pair(x, y);
 }
 
-void CEnemy::move(const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CEnemy::save(CSnapshot & snapshot) const
+{
+    CObject::save(snapshot);
+    snapshot.write(this->frameNumber);
+    snapshot.write(static_cast<uint8_t>(this->currentDirection));
+
+    // The directions which haven't been tried yet are stored as bits
+    uint8_t directions = 0;
+    for (auto direction : this->availableDirections)
+        directions |= 1 << direction;
+    snapshot.write(directions);
+}
+
+void CEnemy::load(CSnapshot & snapshot)
+{
+    CObject::load(snapshot);
+    this->frameNumber = snapshot.read<int>();
+    uint8_t direction = snapshot.read<uint8_t>();
+    if (direction > RIGHT)
+        throw std::invalid_argument("The snapshot contains an unknown direction");
+    this->currentDirection = static_cast<EDirection>(direction);
+
+    uint8_t directions = snapshot.read<uint8_t>();
+    this->availableDirections.clear();
+    for (auto direction : {STAY, UP, DOWN, LEFT, RIGHT})
+        if (directions & (1 << direction))
+            this->availableDirections.insert(direction);
+}
+
+void CEnemy::move(const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
     int dirX = 0;
     int dirY = 0;
@@ -71,7 +102,7 @@ void CEnemy::move(const TileSet & tileSet, const std::list<std::shared_ptr<CObje
     -- this->frameNumber;
     setCollisionBox();
 
-    if (objectCollision(objects, BOOM))
+    if (objectCollision(grid, BOOM))
     {
         this->position.first -= enemySpeed * dirX;
         this->position.second -= enemySpeed * dirY;
@@ -115,16 +146,55 @@ void CEnemy::setDirection()
         return;
     }
 
+    if (this->chase && chasePlayers())
+        return;
+
     // Randomly chooses the direction
     auto it = this->availableDirections.begin();
-    this->currentDirection = *next(it, randomInt(0, this->availableDirections.size() - 1));
+    this->currentDirection = *next(it, this->random->between(0, this->availableDirections.size() - 1));
 
     // Shorten the time for which the enemy stands in place
     // We don't want it to stay in place for too long
     if (this->currentDirection == STAY)
         this->frameNumber = tileWidth / enemySpeed;
     else
-        this->frameNumber = randomInt(1, std::max(mapHeight, mapWidth) / 2) * tileWidth / enemySpeed;
+        this->frameNumber = this->random->between(1, maxWalk) * tileWidth / enemySpeed;
+}
+
+bool CEnemy::chasePlayers()
+{
+    // The enemy can only turn, when it stands right on a tile
+    if (this->position.first % tileWidth || this->position.second % tileWidth)
+        return false;
+
+    int x = this->position.first / tileWidth, y = this->position.second / tileWidth;
+    int distance = this->chase->at(x, y);
+    EDirection closer[4];
+    int count = 0;
+
+    for (auto direction : this->availableDirections)
+    {
+        int next = CFlowField::unreachable;
+        switch (direction)
+        {
+        case UP:    next = this->chase->at(x, y - 1); break;
+        case DOWN:  next = this->chase->at(x, y + 1); break;
+        case LEFT:  next = this->chase->at(x - 1, y); break;
+        case RIGHT: next = this->chase->at(x + 1, y); break;
+        default:    break;
+        }
+
+        if (next < distance)
+            closer[count ++] = direction;
+    }
+
+    if (! count)
+        return false;
+
+    // More ways can be equally short, the enemies shouldn't all take the same one
+    this->currentDirection = closer[count > 1 ? this->random->between(0, count - 1) : 0];
+    this->frameNumber = tileWidth / enemySpeed;
+    return true;
 }
 
 void CEnemy::setCollisionBox()
@@ -0,0 +1,145 @@
+#include "CEventQueue.hpp"
+
+CEventQueue::CEventQueue(const size_t & capacity)
+{
+    this->events.reserve(capacity);
+}
+
+void CEventQueue::removeConsumed()
+{
+    this->events.erase(std::remove_if(this->events.begin(), this->events.end(),
+                                      [] (const SEvent & event) { return event.consumed; }),
+                       this->events.end());
+}
+
+void CEventQueue::clear() { this->events.clear(); }
+
+size_t CEventQueue::size() const { return this->events.size(); }
+
+void CEventQueue::save(CSnapshot & snapshot) const
+{
+    using namespace std;
+
+    snapshot.write(static_cast<uint32_t>(this->events.size()));
+
+    for (auto & event : this->events)
+    {
+        snapshot.write(static_cast<uint8_t>(event.type));
+        snapshot.write(static_cast<uint8_t>(event.data.index()));
+        snapshot.write(event.consumed);
+
+        // The data is written field by field, the positions aren't trivially copyable
+        if (auto data = get_if<SPlaceBomb>(&event.data))
+        {
+            snapshot.write(data->position.first);
+            snapshot.write(data->position.second);
+            snapshot.write(data->size);
+        }
+        else if (auto data = get_if<SPlaceExplosion>(&event.data))
+        {
+            snapshot.write(data->position.first);
+            snapshot.write(data->position.second);
+        }
+        else if (auto data = get_if<SGetBonus>(&event.data))
+        {
+            snapshot.write(static_cast<uint8_t>(data->bonus));
+            snapshot.write(data->strength);
+            snapshot.write(static_cast<uint8_t>(data->player));
+        }
+        else if (auto data = get_if<SPoints>(&event.data))
+            snapshot.write(data->points);
+        else if (auto data = get_if<SPlayerDead>(&event.data))
+            snapshot.write(static_cast<uint8_t>(data->player));
+    }
+}
+
+void CEventQueue::load(CSnapshot & snapshot)
+{
+    using namespace std;
+
+    this->events.clear();
+    uint32_t count = snapshot.read<uint32_t>();
+
+    for (uint32_t i = 0; i < count; ++ i)
+    {
+        SEvent event;
+        uint8_t type = snapshot.read<uint8_t>();
+        if (type > EEvent_MAX)
+            throw invalid_argument("The snapshot contains an unknown event");
+        event.type = static_cast<EEvent>(type);
+        uint8_t index = snapshot.read<uint8_t>();
+        event.consumed = snapshot.read<bool>();
+
+        // The indices follow the order of the types in the variant
+        switch (index)
+        {
+        case 0:
+            break;
+
+        case 1:
+        {
+            int x = snapshot.read<int>();
+            int y = snapshot.read<int>();
+            event.data = SPlaceBomb{make_pair(x, y), snapshot.read<int>()};
+            break;
+        }
+        case 2:
+        {
+            int x = snapshot.read<int>();
+            int y = snapshot.read<int>();
+            event.data = SPlaceExplosion{make_pair(x, y)};
+            break;
+        }
+        case 3:
+        {
+            auto bonus = static_cast<EBonusType>(snapshot.read<uint8_t>());
+            int strength = snapshot.read<int>();
+            event.data = SGetBonus{bonus, strength, static_cast<ETileType>(snapshot.read<uint8_t>())};
+            break;
+        }
+        case 4:
+            event.data = SPoints{snapshot.read<int>()};
+            break;
+
+        case 5:
+            event.data = SPlayerDead{static_cast<ETileType>(snapshot.read<uint8_t>())};
+            break;
+
+        default:
+            throw invalid_argument("The snapshot contains an unknown event");
+        }
+
+        // The events get handled by their type, which must come with its own data
+        if (index != dataIndex(event.type))
+            throw invalid_argument("The snapshot contains an event with the data of another one");
+
+        this->events.push_back(event);
+    }
+}
+
+size_t CEventQueue::dataIndex(const EEvent & type)
+{
+    switch (type)
+    {
+    case PLACE_BOMB:
+        return 1;
+    case PLACE_EXPLOSION:
+        return 2;
+    case GET_BONUS:
+        return 3;
+    case POINTS:
+        return 4;
+    case PLAYER_DEAD:
+        return 5;
+    default:
+        return 0;
+    }
+}
+
+std::vector<SEvent>::iterator CEventQueue::begin() { return this->events.begin(); }
+
+std::vector<SEvent>::iterator CEventQueue::end() { return this->events.end(); }
+
+std::vector<SEvent>::const_iterator CEventQueue::begin() const { return this->events.begin(); }
+
+std::vector<SEvent>::const_iterator CEventQueue::end() const { return this->events.end(); }
\ No newline at end of file
@@ -3,15 +3,26 @@
 CExplosion::CExplosion(const std::pair<int, int> & position, const ETileType & tile,
                        const std::shared_ptr<CRenderWindow::CTexture> & texture)
 : CObject(position, tile, texture),
-  duration(FPS / 2)
+  duration(tickRate / 2)
 {}
 
-void CExplosion::update(Events & events, const TileSet & tileSet,
-                        const std::list<std::shared_ptr<CObject>> & objects)
+void CExplosion::update(CEventQueue & events, const CTileGrid & tileSet,
+                        const CSpatialGrid & grid)
 {
-    render();
     -- this->duration;
 
     if (! this->duration)
         this->toRemove = true;
+}
+
+void CExplosion::save(CSnapshot & snapshot) const
+{
+    CObject::save(snapshot);
+    snapshot.write(this->duration);
+}
+
+void CExplosion::load(CSnapshot & snapshot)
+{
+    CObject::load(snapshot);
+    this->duration = snapshot.read<int>();
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "CFlowField.hpp"
+
+CFlowField::CFlowField()
+: width(0),
+  height(0),
+  dirty(true)
+{}
+
+void CFlowField::invalidate() { this->dirty = true; }
+
+void CFlowField::update(const CTileGrid & tiles, const std::vector<std::pair<int,int>> & targets)
+{
+    if (! this->dirty && targets == this->targets)
+        return;
+
+    this->dirty = false;
+    this->targets = targets;
+    this->width = tiles.getWidth();
+    this->height = tiles.getHeight();
+    this->distances.assign(this->width * this->height, unreachable);
+    this->frontier.clear();
+
+    for (auto & target : targets)
+    {
+        int index = target.second * this->width + target.first;
+        if (this->distances[index] == unreachable)
+        {
+            this->distances[index] = 0;
+            this->frontier.push_back(index);
+        }
+    }
+
+    // The frontier only grows, the tiles are taken from its front in the order they were found
+    for (size_t next = 0; next < this->frontier.size(); ++ next)
+    {
+        int index = this->frontier[next];
+        int x = index % this->width, y = index / this->width;
+
+        for (auto neighbour : {std::make_pair(x, y - 1), std::make_pair(x, y + 1), std::make_pair(x - 1, y), std::make_pair(x + 1, y)})
+        {
+            // Stay inside of the map, even when it isn't framed by walls
+            if (neighbour.first < 0 || neighbour.second < 0 || neighbour.first >= this->width || neighbour.second >= this->height)
+                continue;
+
+            int other = neighbour.second * this->width + neighbour.first;
+            if (this->distances[other] != unreachable || tiles.isSolid(neighbour.first, neighbour.second))
+                continue;
+
+            this->distances[other] = this->distances[index] + 1;
+            this->frontier.push_back(other);
+        }
+    }
+}
+
+int CFlowField::at(const int & x, const int & y) const
+{
+    if (x < 0 || y < 0 || x >= this->width || y >= this->height)
+        return unreachable;
+
+    return this->distances[y * this->width + x];
+}
\ No newline at end of file
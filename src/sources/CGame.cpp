@@ -4,6 +4,7 @@ CGame::CGame(const char * title)
 : startGame(false),
   mode(SINGLEPLAYER),
   window(nullptr),
+  config(nullptr),
   map(nullptr),
   manager(nullptr),
   UI(nullptr)
@@ -13,6 +14,7 @@ CGame::CGame(const char * title)
     {
         initSDL();
         checkConfig();
+        this->config.reset(new CConfig());
         this->window = new CRenderWindow(title, screenWidth, screenHeight);
         newMap();
         this->gameOn = true;
@@ -40,6 +42,10 @@ CGame::CGame(const char * title)
 
 CGame::~CGame()
 {
+    // The manager's textures must be destroyed before the renderer
+    this->manager.reset();
+    this->audio.reset();
+    this->input.stop();
     delete this->window;
     
     // Properly close all subsystems and libraries for SDL
@@ -49,6 +55,12 @@ CGame::~CGame()
     SDL_Quit();
 }
 
+void CGame::recordInto(const std::string & filePath) { this->recordFile = filePath; }
+
+void CGame::playReplay(const std::string & filePath) { this->replayFile = filePath; }
+
+void CGame::profileInto(const std::string & filePath) { this->profileFile = filePath; }
+
 void CGame::run()
 {
     using std::cout, std::endl, std::runtime_error;
@@ -57,6 +69,9 @@ void CGame::run()
     if (! this->gameOn)
         return;
 
+    auto runStart = std::chrono::steady_clock::now();
+    bool firstFrame = true;
+
     // Initialize needed calsses
     try { this->window->startRender(); }
     catch (const runtime_error & err)
@@ -65,10 +80,28 @@ void CGame::run()
         cout << err.what() << endl;
         return;
     }
-    this->UI.reset(new CUserInterface(this->window));
-    this->manager.reset(new CObjectEventManager(this->window));
+    this->UI.reset(new CUserInterface(this->window, *this->config));
+    this->input.start();
+    this->manager.reset(new CObjectEventManager(*this->config, this->random, this->window));
+
+    try { this->audio.reset(new CAudio()); }
+    catch (const runtime_error & err)
+    {
+        cout << "\033[1;31mTHE GAME GOES ON WITHOUT SOUND DUE TO ISSUES IN OPENING THE AUDIO:\033[0m" << endl;
+        cout << err.what() << endl;
+    }
+
+    if (! this->replayFile.empty() && ! startReplay())
+        return;
+
+    if (! this->profileFile.empty())
+    {
+        this->profiler.reset(new CProfiler(this->profileFile));
+        this->profiler->attach();
+    }
 
     // Start the game clock
+    CClock clock;
     Uint32 frameStart = 0;
     int frameTime = 0;
 
@@ -76,34 +109,95 @@ void CGame::run()
     while(this->isRunning())
     {
         frameStart = SDL_GetTicks();
-        this->handleEvents();
+        if (this->profiler)
+            this->profiler->beginFrame();
 
-        if (this->manager->needsNewMap)
         {
-            this->newMap();
-            this->manager->loadFromMap(this->map->getMap().first);
+            CProfiler::CZone zone("handleEvents");
+            this->handleEvents();
         }
+
         // The game has ended, show the UI
-        if (this->manager->endGame)
+        if (this->manager->endGame && this->startGame)
         {
+            if (! this->replayFile.empty())
+            {
+                finishReplay();
+                break;
+            }
+            this->stopRecording();
             this->startGame = false;
+            this->saveHighScore();
             this->UI->show();
         }
 
-        this->window->clear();
-        this->UI->render();
+        // Simulate as many time frames as fit into the real time passed,
+        // each of them gets the input which happened until its end.
+        // A finished game isn't simulated any further, the menu shows up in the next frame
+        clock.startFrame();
         if (this->startGame)
         {
-            this->manager->update();
-            this->manager->manageEvents();
+            while (! this->manager->endGame && clock.tick())
+            {
+                SInputFrame frame = this->input.poll(clock.simulatedUntil());
+                if (! this->replayFile.empty() && ! this->replay.next(frame))
+                {
+                    finishReplay();
+                    break;
+                }
+                CProfiler::CZone zone("tick");
+                this->manager->tick(frame);
+
+                if (! this->recordFile.empty())
+                    this->replay.record(frame);
+            }
+
+            // The events of all the time frames simulated now sound together
+            uint32_t fired = this->manager->takeFiredEvents();
+            if (this->audio)
+                this->audio->play(fired);
+        }
+        else
+        {
+            // The keys pressed in the menu don't get into the game
+            clock.reset();
+            this->input.poll(clock.simulatedUntil());
+        }
+
+        // Rendering gets skipped, when the game logic falls behind
+        if (clock.shouldRender())
+        {
+            this->window->clear();
+            {
+                CProfiler::CZone zone("UI render");
+                this->UI->render();
+            }
+            if (this->startGame)
+                this->manager->render(clock.alpha());
+
+            CProfiler::CZone zone("display");
+            this->window->display();
+
+            if (firstFrame)
+            {
+                firstFrame = false;
+                reportStartup(runStart);
+            }
         }
-        this->window->display();
 
-        // Delay the game as much as needed to maintain the same lenght of the frames
+        if (this->profiler)
+            endProfiledFrame();
+
+        // Delay the game as much as needed to maintain the maximal frame rate,
+        // the input keeps being pumped meanwhile, so it gets the right timestamps
         frameTime = SDL_GetTicks() - frameStart;
         if (frameDelay > frameTime)
-            SDL_Delay(frameDelay - frameTime);
+            this->input.pumpUntil(frameStart + frameDelay);
     }
+
+    // Everything the profiler still keeps gets written, once the game ends
+    if (this->profiler)
+        saveProfile();
 }
 
 void CGame::handleEvents()
@@ -116,15 +210,35 @@ void CGame::handleEvents()
     {
         // Close the game window and end the program
         if (event.type == SDL_QUIT)
+        {
+            this->stopRecording();
             this->gameOn = false;
-        
-        const uint8_t * currentKeyStates = SDL_GetKeyboardState(nullptr);
+        }
+
+        // The renderer lost the content of the textures it rendered into
+        if (event.type == SDL_RENDER_TARGETS_RESET)
+            this->manager->invalidateBackground();
+
+        // Game controllers connected or disconnected
+        this->input.handleEvent(&event);
 
         // Quicksave in singleplayer mode
-        if (currentKeyStates[SDL_SCANCODE_F5] && this->mode == SINGLEPLAYER && this->startGame)
+        if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F5 && ! event.key.repeat && this->mode == SINGLEPLAYER && this->startGame && this->replayFile.empty())
         {
             this->map->setMap(this->manager->saveIntoMap());
             this->map->save();
+
+            // The map loses the state of the objects, the snapshot keeps all of it
+            try
+            {
+                this->manager->snapshot(this->quicksave);
+                this->quicksave.save(stateFile());
+            }
+            catch (const FileException & err)
+            {
+                cout << "\033[1;31mTHE SNAPSHOT OF THE GAME COULD NOT BE SAVED:\033[0m" << endl;
+                cout << err.what() << endl;
+            }
         }
         // UI events - signals which button was pressed (if any)
         switch (this->UI->handleEvents(&event))
@@ -135,11 +249,18 @@ void CGame::handleEvents()
             break;
 
         case UI_LOAD:
+            // Only singleplayer games can be saved
+            this->mode = SINGLEPLAYER;
             this->startGame = true;
             try
             {
-                this->map->load();
-                this->manager->startGame(this->map->getMap());
+                CProfiler::CZone zone("load level");
+                if (! loadState())
+                {
+                    this->map->load();
+                    this->manager->startGame(this->map->getMap());
+                }
+                startRecording();
             }
             // In case the game could not be loaded from the file, write an error message
             // into the terminal and don't do anything
@@ -172,8 +293,13 @@ void CGame::handleEvents()
             break;
         }
         // Jump to UI (discarding the current game)
-        if (currentKeyStates[SDL_SCANCODE_ESCAPE])
+        if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_ESCAPE)
         {
+            // There is nothing else to do while watching a replay
+            if (! this->replayFile.empty())
+                this->gameOn = false;
+
+            this->stopRecording();
             this->startGame = false;
             this->UI->show();
         }
@@ -182,13 +308,169 @@ void CGame::handleEvents()
 
 bool CGame::isRunning() const { return this->gameOn; }
 
-void CGame::newMap() { this->map.reset(new CMap(this->mode)); }
+void CGame::newMap() { this->map.reset(new CMap(this->mode, this->random, *this->config)); }
 
 void CGame::newGame()
 {
+    using std::cout, std::endl;
+
+    this->random.seed(this->config->get(CONFIG_SEED));
+    cout << "Seed: " << this->random.getSeed() << endl;
+
+    CProfiler::CZone zone("load level");
     this->startGame = true;
     this->newMap();
     this->manager->startGame(this->map->getMap());
+    startRecording();
+}
+
+void CGame::saveHighScore()
+{
+    using std::cout, std::endl;
+
+    int score = this->manager->getScores().first;
+    if (this->mode != SINGLEPLAYER || score <= this->config->get(CONFIG_HIGH_SCORE))
+        return;
+
+    try { this->config->set(CONFIG_HIGH_SCORE, score); }
+    catch (const FileException & err)
+    {
+        cout << "\033[1;31mTHE HIGH SCORE COULD NOT BE SAVED:\033[0m" << endl;
+        cout << err.what() << endl;
+    }
+}
+
+std::string CGame::stateFile() const
+{
+    return this->config->getText(CONFIG_SAVE_FILE) + ".state";
+}
+
+bool CGame::loadState()
+{
+    using std::cout, std::endl, std::invalid_argument;
+
+    try { this->quicksave.load(stateFile()); }
+    catch (const FileException & err) { return false; }
+
+    try { this->manager->restore(this->quicksave); }
+    catch (const invalid_argument & err)
+    {
+        cout << "\033[1;31mTHE SNAPSHOT OF THE GAME IS CORRUPTED, LOADING THE MAP INSTEAD:\033[0m" << endl;
+        cout << err.what() << endl;
+        return false;
+    }
+
+    return true;
+}
+
+void CGame::startRecording()
+{
+    if (! this->recordFile.empty())
+        this->replay.begin(*this->manager, *this->config);
+}
+
+void CGame::stopRecording()
+{
+    using std::cout, std::endl;
+
+    if (this->recordFile.empty() || ! this->startGame)
+        return;
+
+    try
+    {
+        this->replay.end(*this->manager);
+        this->replay.save(this->recordFile);
+        cout << "Replay of " << this->replay.getTicks() << " time frames saved into " << this->recordFile << endl;
+    }
+    catch (const FileException & err)
+    {
+        cout << "\033[1;31mTHE REPLAY COULD NOT BE SAVED:\033[0m" << endl;
+        cout << err.what() << endl;
+    }
+}
+
+bool CGame::startReplay()
+{
+    using std::cout, std::endl, std::invalid_argument;
+
+    try
+    {
+        this->replay.load(this->replayFile);
+        this->replay.play(*this->manager, *this->config);
+    }
+    catch (const FileException & err)
+    {
+        cout << "\033[1;31mTHE REPLAY COULD NOT BE LOADED:\033[0m" << endl;
+        cout << err.what() << endl;
+        return false;
+    }
+    catch (const invalid_argument & err)
+    {
+        cout << "\033[1;31mTHE REPLAY IS CORRUPTED:\033[0m" << endl;
+        cout << err.what() << endl;
+        return false;
+    }
+
+    this->UI->hide();
+    this->startGame = true;
+    return true;
+}
+
+void CGame::finishReplay()
+{
+    using std::cout, std::endl;
+
+    if (this->replay.check(*this->manager))
+        cout << "The replay of " << this->replay.getTicks() << " time frames ended in the recorded state" << endl;
+    else
+        cout << "\033[1;31mTHE REPLAY DIVERGED FROM THE RECORDED GAME\033[0m" << endl;
+
+    this->startGame = false;
+    this->gameOn = false;
+}
+
+void CGame::endProfiledFrame()
+{
+    using std::cout, std::endl;
+
+    // The game goes on without the profiler, the failure only gets reported
+    try { this->profiler->endFrame(); }
+    catch (const FileException & err)
+    {
+        cout << "\033[1;31mTHE CAPTURED SLOW FRAMES COULD NOT BE SAVED, PROFILING STOPS:\033[0m" << endl;
+        cout << err.what() << endl;
+        this->profiler.reset();
+    }
+}
+
+void CGame::saveProfile()
+{
+    using std::cout, std::endl;
+
+    try
+    {
+        this->profiler->save();
+        cout << "The profile of the last frames saved into " << this->profileFile << endl;
+    }
+    catch (const FileException & err)
+    {
+        cout << "\033[1;31mTHE PROFILE COULD NOT BE SAVED:\033[0m" << endl;
+        cout << err.what() << endl;
+    }
+    this->profiler.reset();
+}
+
+void CGame::reportStartup(const std::chrono::steady_clock::time_point & runStart) const
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    if (! this->profiler)
+        return;
+
+    CRenderWindow::SStartupTimes times = this->window->getStartupTimes();
+    cout << "Startup: assets " << (times.fromPack ? "read from the asset pack" : "decoded") << " in " << times.decode << " ms, textures created in " << times.upload
+         << " ms, first frame displayed after " << duration<double, milli>(steady_clock::now() - runStart).count() << " ms" << endl;
 }
 
 void CGame::initSDL()
@@ -207,8 +489,12 @@ void CGame::checkConfig()
         throw invalid_argument("Invalid tile width. Minimum: 64, maximum: 256. Must be a multiple of 32.\nYours: "s
         .append(to_string(tileWidth)));
 
-    if (FPS < 60)
-        throw invalid_argument("Invalid FPS. Minimum: 60. Game would be lagging otherwise.");
+    if (tickRate < 60 || enemySpeed < 1)
+        throw invalid_argument("Invalid tick rate. Minimum: 60. Game would be lagging otherwise.\n"
+                               "Maximum: the entities must move at least one pixel per time frame.");
+
+    if (FPS < 30)
+        throw invalid_argument("Invalid FPS. Minimum: 30.");
 
     if (screenWidth < 5 * tileWidth || screenHeight < 5 * tileWidth 
      || screenWidth > 2240 / tileWidth * tileWidth || screenHeight > 1440 / tileWidth * tileWidth)
@@ -217,33 +503,4 @@ void CGame::checkConfig()
         .append("\nScreen height: ").append(to_string(5 * tileWidth))
         .append("\n\nThe maximum is:\nScreen width: ").append(to_string(2240 / tileWidth * tileWidth))
         .append("\nScreen height: ").append(to_string(1440 / tileWidth * tileWidth)));
-
-    if (loadData(config,"High score") < 0)
-        throw invalid_argument("Negative high score");
-
-    loadData(config,"Save file", true);
-
-    int tmp = loadData(config,"Enemies");
-    if (tmp < 0 || tmp > 10)
-        throw invalid_argument("Invalid number of enemies. Minimum: 0, maximum: 10");
-
-    tmp = loadData(config,"Breakables");
-    if (tmp < 0 || tmp > 100)
-        throw invalid_argument("Invalid number of breakables. Minimum: 0, maximum: 100");
-    
-    tmp = loadData(config,"Duel rounds");
-    if (tmp < 1 || tmp > 10)
-        throw invalid_argument("Invalid number of duel rounds. Minimum: 1, maximum: 10");
-
-    tmp = loadData(config,"Bonus chance");
-    if (tmp < 0 || tmp > 100)
-        throw invalid_argument("Invalid bonus chance in percent. Minimum: 0, maximum: 100");
-
-    tmp = loadData(config,"Bonus mega bombs");
-    if (tmp < 1)
-        throw invalid_argument("Invalid mega bombs bonus size. Minimum: 0");
-
-    tmp = loadData(config,"Bonus speed");
-    if (tmp < 0)
-        throw invalid_argument("Invalid speed bonus size. Minimum: 0");
 }
\ No newline at end of file
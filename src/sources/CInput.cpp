@@ -0,0 +1,173 @@
+#include "CInput.hpp"
+
+bool SInputFrame::operator == (const SInputFrame & other) const
+{
+    return this->players[0] == other.players[0] && this->players[1] == other.players[1];
+}
+
+bool SInputFrame::operator != (const SInputFrame & other) const { return ! (*this == other); }
+
+const std::array<CInput::SBinding, 2> CInput::bindings = {{
+    {SDL_SCANCODE_W,  SDL_SCANCODE_S,    SDL_SCANCODE_A,    SDL_SCANCODE_D,     SDL_SCANCODE_SPACE},
+    {SDL_SCANCODE_UP, SDL_SCANCODE_DOWN, SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDL_SCANCODE_RCTRL}
+}};
+
+CInput::CInput()
+: held{},
+  latched{},
+  controllers{},
+  sticks{},
+  started(false)
+{
+    for (auto & id : this->controllerIds)
+        id = -1;
+}
+
+CInput::~CInput()
+{
+    this->stop();
+}
+
+void CInput::start()
+{
+    // The game is played from the keyboard as well, it doesn't need the controllers
+    SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER);
+    SDL_AddEventWatch(watch, this);
+    this->started = true;
+}
+
+void CInput::stop()
+{
+    if (this->started)
+        SDL_DelEventWatch(watch, this);
+    this->started = false;
+
+    for (size_t i = 0; i < this->controllers.size(); ++ i)
+        if (this->controllers[i])
+        {
+            this->controllerIds[i] = -1;
+            SDL_GameControllerClose(this->controllers[i]);
+            this->controllers[i] = nullptr;
+        }
+}
+
+void CInput::handleEvent(const SDL_Event * event)
+{
+    // A new controller plays for the first player without one
+    if (event->type == SDL_CONTROLLERDEVICEADDED && SDL_IsGameController(event->cdevice.which))
+        for (size_t i = 0; i < this->controllers.size(); ++ i)
+            if (! this->controllers[i])
+            {
+                this->controllers[i] = SDL_GameControllerOpen(event->cdevice.which);
+                if (this->controllers[i])
+                    this->controllerIds[i] = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(this->controllers[i]));
+                break;
+            }
+
+    if (event->type == SDL_CONTROLLERDEVICEREMOVED)
+        for (size_t i = 0; i < this->controllers.size(); ++ i)
+            if (this->controllers[i] && this->controllerIds[i] == event->cdevice.which)
+            {
+                this->controllerIds[i] = -1;
+                SDL_GameControllerClose(this->controllers[i]);
+                this->controllers[i] = nullptr;
+            }
+}
+
+void CInput::record(const SDL_Event * event)
+{
+    // The keys held down repeat, only the first press counts
+    if ((event->type == SDL_KEYDOWN || event->type == SDL_KEYUP) && ! event->key.repeat)
+        for (size_t i = 0; i < this->bindings.size(); ++ i)
+        {
+            const SBinding & keys = this->bindings[i];
+            SDL_Scancode key = event->key.keysym.scancode;
+            uint8_t action = key == keys.up ? INPUT_UP : key == keys.down ? INPUT_DOWN : key == keys.left ? INPUT_LEFT
+                           : key == keys.right ? INPUT_RIGHT : key == keys.bomb ? INPUT_BOMB : 0;
+            if (action)
+                this->queue.push(SInputEvent{event->key.timestamp, (uint8_t)i, action, event->type == SDL_KEYDOWN});
+        }
+
+    if (event->type == SDL_CONTROLLERBUTTONDOWN || event->type == SDL_CONTROLLERBUTTONUP)
+        for (size_t i = 0; i < this->controllerIds.size(); ++ i)
+        {
+            if (this->controllerIds[i] != event->cbutton.which)
+                continue;
+
+            uint8_t button = event->cbutton.button;
+            uint8_t action = button == SDL_CONTROLLER_BUTTON_DPAD_UP ? INPUT_UP : button == SDL_CONTROLLER_BUTTON_DPAD_DOWN ? INPUT_DOWN
+                           : button == SDL_CONTROLLER_BUTTON_DPAD_LEFT ? INPUT_LEFT : button == SDL_CONTROLLER_BUTTON_DPAD_RIGHT ? INPUT_RIGHT
+                           : button == SDL_CONTROLLER_BUTTON_A ? INPUT_BOMB : 0;
+            if (action)
+                this->queue.push(SInputEvent{event->cbutton.timestamp, (uint8_t)i, action, event->type == SDL_CONTROLLERBUTTONDOWN});
+        }
+
+    // The left stick moves the player too, only its crossing of the threshold is an event
+    if (event->type == SDL_CONTROLLERAXISMOTION)
+        for (size_t i = 0; i < this->controllerIds.size(); ++ i)
+        {
+            if (this->controllerIds[i] != event->caxis.which)
+                continue;
+
+            Sint16 value = event->caxis.value;
+            if (event->caxis.axis == SDL_CONTROLLER_AXIS_LEFTX)
+                recordStick(i, event->caxis.timestamp, INPUT_LEFT | INPUT_RIGHT,
+                            value < -stickThreshold ? INPUT_LEFT : value > stickThreshold ? INPUT_RIGHT : 0);
+            if (event->caxis.axis == SDL_CONTROLLER_AXIS_LEFTY)
+                recordStick(i, event->caxis.timestamp, INPUT_UP | INPUT_DOWN,
+                            value < -stickThreshold ? INPUT_UP : value > stickThreshold ? INPUT_DOWN : 0);
+        }
+}
+
+SInputFrame CInput::poll(const Uint32 & until)
+{
+    SInputEvent event;
+
+    // The timestamps wrap around after 49 days, the difference still orders them
+    while (this->queue.front(event) && (Sint32)(event.timestamp - until) <= 0)
+    {
+        this->queue.pop();
+        if (event.pressed)
+        {
+            this->held.players[event.player] |= event.action;
+            this->latched.players[event.player] |= event.action;
+        }
+        else
+            this->held.players[event.player] &= ~event.action;
+    }
+
+    SInputFrame frame{};
+    for (size_t i = 0; i < this->bindings.size(); ++ i)
+        frame.players[i] = this->held.players[i] | this->latched.players[i];
+
+    this->latched = SInputFrame{};
+    return frame;
+}
+
+void CInput::pumpUntil(const Uint32 & deadline) const
+{
+    while ((Sint32)(SDL_GetTicks() - deadline) < 0)
+    {
+        SDL_PumpEvents();
+        SDL_Delay(1);
+    }
+}
+
+int CInput::watch(void * input, SDL_Event * event)
+{
+    static_cast<CInput *>(input)->record(event);
+    return 1;
+}
+
+void CInput::recordStick(const uint8_t & player, const Uint32 & timestamp, const uint8_t & mask, const uint8_t & direction)
+{
+    uint8_t & stick = this->sticks[player];
+    if ((stick & mask) == direction)
+        return;
+
+    for (uint8_t action : {INPUT_UP, INPUT_DOWN, INPUT_LEFT, INPUT_RIGHT})
+        if ((mask & action) && (stick & action) != (direction & action))
+            this->queue.push(SInputEvent{timestamp, player, action, (direction & action) != 0});
+
+    stick = (stick & ~mask) | direction;
+}
\ No newline at end of file
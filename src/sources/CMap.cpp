@@ -1,41 +1,44 @@
 #include "CMap.hpp"
 
-int CMap::numberOfBreakables = -1;
-int CMap::numberOfEnemies = -1;
-
-CMap::CMap(const EGameMode & mode, const std::string & saveFile)
-: score(0),
-  saveFile(saveFile)
+CMap::CMap(const EGameMode & mode, CRandom & random, const CConfig & config, const std::string & saveFile)
+: width(config.get(CONFIG_MAP_WIDTH)),
+  height(config.get(CONFIG_MAP_HEIGHT)),
+  reserved(this->width * this->height, false),
+  freeTiles(0),
+  numberOfBreakables(config.get(CONFIG_BREAKABLES)),
+  numberOfEnemies(config.get(CONFIG_ENEMIES)),
+  score(0),
+  saveFile(saveFile.empty() ? config.getText(CONFIG_SAVE_FILE) : saveFile),
+  random(random)
 {    
-    using std::vector, std::make_pair;
+    using std::vector, std::move;
 
-    if (this->numberOfBreakables == -1 || this->numberOfEnemies == -1)
-    {
-        this->numberOfBreakables = loadData(config, "Breakables");
-        this->numberOfEnemies = loadData(config, "Enemies");
-    }
+    this->map.reserve(this->height);
+    this->availableTiles.reserve(this->width * this->height);
 
     // Sets up all the unbreakable walls and the wallkable (empty) tiles
-    for (int y = 0; y != mapHeight; ++ y)
+    for (int y = 0; y != this->height; ++ y)
     {        
         vector<ETileType> tmp;
-        for (int x = 0; x != mapWidth; ++ x)
+        tmp.reserve(this->width);
+        for (int x = 0; x != this->width; ++ x)
         {
-            if (y == 0 || y == mapHeight - 1)
+            if (y == 0 || y == this->height - 1)
                 tmp.push_back(WALL);
 
-            else if ((x % 2 == 0 && y % 2 == 0) || x == 0 || x == mapWidth - 1)
+            else if ((x % 2 == 0 && y % 2 == 0) || x == 0 || x == this->width - 1)
                 tmp.push_back(WALL);
 
             else
             {
                 tmp.push_back(EMPTY);
-                this->availableTiles.insert(make_pair(x, y));
+                this->availableTiles.push_back(y * this->width + x);
             }
         }
-        this->map.push_back(tmp);
-        tmp.clear();
+        this->map.push_back(move(tmp));
     }
+    this->freeTiles = this->availableTiles.size();
+
     // Tiles taken by players, enemies and the ones around the players get reserved
     // during the map's creation, so they are not rewritten to something else
     setPlayer(PLAYER1);
@@ -59,15 +62,15 @@ void CMap::save() const
     stringstream stream("");
 
     // Create a stream of enums out of the map
-    for (int y = 0; y != mapHeight; ++ y)
+    for (int y = 0; y != this->height; ++ y)
     {
-        for (int x = 0; x != mapWidth; ++ x)
+        for (int x = 0; x != this->width; ++ x)
         {
             stream << this->map[y][x];
-            if (x != mapWidth - 1)
+            if (x != this->width - 1)
                 stream << " ";
         }
-        if (y != mapHeight - 1)
+        if (y != this->height - 1)
             stream << "\n";
     }
     // Finally save the map
@@ -88,7 +91,7 @@ void CMap::load()
     Map res;                                                            // result map
 
     // Loads the stream line by line and then parses it into separate tiles
-    for (int j = 0; j < mapHeight; ++ j)
+    for (int j = 0; j < this->height; ++ j)
     {
         vector<ETileType> tmp;
         getline(map, line);
@@ -96,12 +99,12 @@ void CMap::load()
         stringstream num(line);
         int n;
 
-        for(int i = 0; i < mapWidth; ++ i)
+        for(int i = 0; i < this->width; ++ i)
         {
             // Load tile by tile
             num >> n;
             // Checks, whether the width of the map is correct
-            if (num.eof() && i + 1 != mapWidth)
+            if (num.eof() && i + 1 != this->width)
                 mapLoadError();
 
             // Check, whether the tiles are in range
@@ -117,7 +120,7 @@ void CMap::load()
 
         res.push_back(tmp);
 
-        if (map.eof() && j + 1 != mapHeight)
+        if (map.eof() && j + 1 != this->height)
             mapLoadError();
     }
     // Checks, whether the height of the map is correct
@@ -147,7 +150,7 @@ void CMap::setEnemies()
 {
     for (int i = 0; i < this->numberOfEnemies; ++ i)
     {
-        if (this->availableTiles.empty())
+        if (! this->freeTiles)
             break;
         takeRandomTile(ENEMY);
     }
@@ -157,7 +160,7 @@ void CMap::setBreakables()
 {
     for (int i = 0; i < this->numberOfBreakables; ++ i)
     {
-        if (this->availableTiles.empty())
+        if (! this->freeTiles)
             break;
         takeRandomTile(BREAKABLE);
     }
@@ -165,29 +168,34 @@ void CMap::setBreakables()
 
 std::pair<int, int> CMap::takeRandomTile(const ETileType & tileType)
 {
-    // Randomly chooses an available tile
-    auto selectRandom = [&] ()
+    int tile;
+
+    // Randomly chooses an available tile, the reserved ones get thrown away on the way
+    do
     {
-        auto it = this->availableTiles.begin();
-        std::advance(it, randomInt(0, this->availableTiles.size() - 1));
-        return it;
-    };
-
-    auto tile = selectRandom();
-    // A temporary copy is needed so we can continue working with the data after erasing
-    // the iterator from the container
-    auto tmp = *tile;
-    this->availableTiles.erase(tile);
-    setTile(tmp.first, tmp.second, tileType);
-
-    return tmp;
+        int index = this->random.between(0, this->availableTiles.size() - 1);
+        tile = this->availableTiles[index];
+        this->availableTiles[index] = this->availableTiles.back();
+        this->availableTiles.pop_back();
+    }
+    while (this->reserved[tile]);
+
+    -- this->freeTiles;
+    setTile(tile % this->width, tile / this->width, tileType);
+
+    return std::make_pair(tile % this->width, tile / this->width);
 }
 
 void CMap::takeAdjacentTiles(const std::pair<int, int> & tile)
 {    
+    // The taken tiles are not EMPTY anymore, the walls never were
     for (int x = tile.first - 1; x <= tile.first + 1; ++ x)
         for (int y = tile.second - 1; y <= tile.second + 1; ++ y)
-            this->availableTiles.erase(std::make_pair(x, y));
+            if (this->map[y][x] == EMPTY && ! this->reserved[y * this->width + x])
+            {
+                this->reserved[y * this->width + x] = true;
+                -- this->freeTiles;
+            }
 }
 
 void CMap::setUp(const Map & newMap)
@@ -195,25 +203,25 @@ void CMap::setUp(const Map & newMap)
     using namespace std;
 
     // Iterate through tiles of the map
-    for (int y = 0; y != mapHeight; ++ y)
+    for (int y = 0; y != this->height; ++ y)
     {
-        for (int x = 0; x != mapWidth; ++ x)
+        for (int x = 0; x != this->width; ++ x)
         {
             // Check, whether the walls are set properly
             if ((  y == 0 
-                || y == mapHeight - 1
+                || y == this->height - 1
                 || (x % 2 == 0 && y % 2 == 0) 
                 || x == 0
-                || x == mapWidth - 1)
+                || x == this->width - 1)
                 && newMap[y][x] != WALL)
                 throw invalid_argument("The map layout is incorrect"s);
 
             // Check, whether the walls aren't where they shouldn't be
             if ((x % 2 != 0 || y % 2 != 0)
               && y != 0
-              && y != mapHeight - 1
+              && y != this->height - 1
               && x != 0
-              && x != mapWidth - 1
+              && x != this->width - 1
               && newMap[y][x] == WALL)
                 throw invalid_argument("The map layout is incorrect"s);
         }
@@ -222,11 +230,11 @@ void CMap::setUp(const Map & newMap)
     this->map = newMap;
 }
 
-void CMap::mapLoadError()
+void CMap::mapLoadError() const
 {
     using namespace std;
 
     throw invalid_argument
     ("The map you are trying to load has invalid dimensions. Required width: "s
-    .append(to_string(mapWidth)).append(", height: ").append(to_string(mapHeight)));
+    .append(to_string(this->width)).append(", height: ").append(to_string(this->height)));
 }
\ No newline at end of file
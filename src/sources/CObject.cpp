@@ -5,26 +5,52 @@ CObject::CObject(const std::pair<int, int> & position,
                  const std::shared_ptr<CRenderWindow::CTexture> & texture)
 : toRemove(false),
   position(scale(position)),
+  previousPosition(this->position),
   texture(texture),
   tile(tile)
 { setCollisionBox(); }
 
 ETileType CObject::getTile() const { return this->tile; }
 
-void CObject::render() const
+void CObject::render(const double & alpha) const
 {
-    this->texture->render(0, 0, this->position.first, this->position.second, tileWidth, tileWidth);
+    auto position = interpolate(alpha);
+    this->texture->render(0, 0, position.first, position.second, tileWidth, tileWidth);
 }
 
-void CObject::createEvents(Events & events, const TileSet & tileSet,
-                           const std::list<std::shared_ptr<CObject>> & objects)
-{}
+std::pair<int, int> CObject::interpolate(const double & alpha) const
+{
+    int x = this->previousPosition.first + (this->position.first - this->previousPosition.first) * alpha;
+    int y = this->previousPosition.second + (this->position.second - this->previousPosition.second) * alpha;
+
+    return std::make_pair(x, y);
+}
 
 std::pair<int, int> CObject::getTilePos() const
 {
     return deScale(this->position);
 }
 
+std::pair<int, int> CObject::getPosition() const { return this->position; }
+
+void CObject::save(CSnapshot & snapshot) const
+{
+    snapshot.write(this->position.first);
+    snapshot.write(this->position.second);
+    snapshot.write(this->previousPosition.first);
+    snapshot.write(this->previousPosition.second);
+    snapshot.write(this->box);
+}
+
+void CObject::load(CSnapshot & snapshot)
+{
+    this->position.first = snapshot.read<int>();
+    this->position.second = snapshot.read<int>();
+    this->previousPosition.first = snapshot.read<int>();
+    this->previousPosition.second = snapshot.read<int>();
+    this->box = snapshot.read<SDL_Rect>();
+}
+
 void CObject::setCollisionBox()
 {
     this->box.x = this->position.first;
@@ -33,43 +59,46 @@ void CObject::setCollisionBox()
     this->box.h = tileWidth;
 }
 
-bool CObject::wallCollision(const TileSet & tileSet,
+bool CObject::wallCollision(const CTileGrid & tileSet,
                             const double & u,
                             const double & d,
                             const double & l,
                             const double & r) const
 {
-    auto tile = getTilePos();
-
-    // Check adjacent tiles for collision
-    for (int y = tile.second - 2; y < tile.second + 2; ++ y)
-    {
-        for (int x = tile.first - 2; x < tile.first + 2; ++ x)
-        {
-            if (x >= 0 && x < mapWidth && y >= 0 && y < mapHeight)
-                if(tileSet[y][x]->tileType == WALL || tileSet[y][x]->tileType == BREAKABLE)
-                {
-                    if(checkCollision(tileSet[y][x]->box, u, d, l, r))
-                    return true;
-                }
-        }
-    }
+    // Negative tolerance widens the collision box, the searched area must cover it
+    int widen = tileWidth * std::max({0.0, - u, - d, - l, - r});
+    SDL_Rect area = {this->box.x - widen, this->box.y - widen, this->box.w + 2 * widen, this->box.h + 2 * widen};
+    SDL_Rect range = tileSet.cells(area);
+
+    // Only the tiles overlapping the searched area can collide
+    for (int y = range.y; y < range.y + range.h; ++ y)
+        for (int x = range.x; x < range.x + range.w; ++ x)
+            if (tileSet.isSolid(x, y) && checkCollision(CTileGrid::box(x, y), u, d, l, r))
+                return true;
 
     return false;
 }
 
-CObject * CObject::objectCollision(const std::list<std::shared_ptr<CObject>> & objects,
+CObject * CObject::objectCollision(const CSpatialGrid & grid,
                                    const ETileType & tileType,
                                    const double & u,
                                    const double & d,
                                    const double & l,
                                    const double & r) const
 {
-    for (auto & obj : objects)
-        if (obj->getTile() == tileType)
-            if (checkCollision(obj->box, u, d, l, r))
-                return obj.get();
-    
+    // Negative tolerance widens the collision box, the searched area must cover it
+    int widen = tileWidth * std::max({0.0, - u, - d, - l, - r});
+    SDL_Rect area = {this->box.x - widen, this->box.y - widen, this->box.w + 2 * widen, this->box.h + 2 * widen};
+    SDL_Rect range = grid.cells(area);
+
+    // Only the objects in the tiles overlapping the searched area can collide
+    for (int y = range.y; y < range.y + range.h; ++ y)
+        for (int x = range.x; x < range.x + range.w; ++ x)
+            for (auto obj : grid.at(x, y))
+                if (obj->getTile() == tileType)
+                    if (checkCollision(obj->box, u, d, l, r))
+                        return obj;
+
     return nullptr;
 }
 
@@ -1,56 +1,138 @@
 #include "CObjectEventManager.hpp"
 
-CObjectEventManager::CObjectEventManager(CRenderWindow * renderer)
+CObjectEventManager::CObjectEventManager(const CConfig & config, CRandom & random, CRenderWindow * renderer)
 : needsNewMap(false),
   endGame(false),
   renderer(renderer),
+  config(config),
+  random(random),
   currentScore(std::make_pair(0,0)),
+  roundsWon(std::make_pair(0,0)),
   alivePlayers(0),
   aliveEnemies(0),
-  rounds(0)
+  rounds(0),
+  firedEvents(0)
 {
-    this->bonusChance = loadData(config, "Bonus chance");
+    // The tiles only hold their type, their textures are looked up once here
+    for (auto tile : {EMPTY, WALL, BREAKABLE})
+        this->tileTextures[tile] = getTexture(tile);
+
+    this->store.reserve(config.get(CONFIG_POOL_BOMBS), config.get(CONFIG_POOL_EXPLOSIONS), config.get(CONFIG_POOL_BONUSES));
 }
 
-void CObjectEventManager::update()
+void CObjectEventManager::tick(const SInputFrame & input)
 {
-    using namespace std;
-    list<list<shared_ptr<CObject>>::iterator> objToRemove;
+    // A finished game stays as it ended, another round would be counted again
+    if (this->endGame)
+        return;
 
-    // Render tiles - walls, breakables and grass
-    for (auto & row : this->tileSet)
-        for (auto & tile : row)
-            tile->update();
+    // Push the players to another level
+    if (this->needsNewMap)
+    {
+        CProfiler::CZone zone("load level");
+        loadFromMap(CMap(this->mode, this->random, this->config).getMap().first);
+    }
 
-    // Update each object
-    for (auto obj = this->objects.begin(); obj != this->objects.end(); ++ obj)
+    update(input);
+    manageEvents();
+}
+
+void CObjectEventManager::render(const double & alpha)
+{
+    // Follow the middle of the players, the views stay where they were once nobody is left
+    this->cameraTargets.clear();
+    for (auto & player : this->store.players)
     {
-        (*obj)->update(this->events, this->tileSet, this->objects);
-        
-        if ((*obj)->toRemove)
-            objToRemove.push_back(obj);
+        auto position = player.interpolate(alpha);
+        this->cameraTargets.emplace_back(position.first + tileWidth / 2, position.second + tileWidth / 2);
+    }
+    this->camera.follow(this->cameraTargets, this->tileSet.getWidth() * tileWidth, this->tileSet.getHeight() * tileWidth);
+
+    for (auto & view : this->camera.getViews())
+    {
+        this->renderer->setView(view.world, view.screen);
+
+        // Render tiles - walls, breakables and grass
+        {
+            CProfiler::CZone zone("render tiles");
+            if (this->background)
+                this->background->render(this->tileSet, this->tileTextures, view.world);
+        }
+
+        CProfiler::CZone zone("render objects");
+        renderObjects(view.world, alpha);
     }
+    this->renderer->resetView();
+
+    for (auto & player : this->store.players)
+        player.renderScore();
+}
+
+void CObjectEventManager::renderObjects(const SDL_Rect & view, const double & alpha) const
+{
+    // The sprites are one tile large and drawn between the last two positions,
+    // so the objects registered in the tiles around the view can still reach into it
+    SDL_Rect range = this->store.grid.cells({view.x - tileWidth, view.y - tileWidth, view.w + 2 * tileWidth, view.h + 2 * tileWidth});
+
+    for (int y = range.y; y < range.y + range.h; ++ y)
+        for (int x = range.x; x < range.x + range.w; ++ x)
+            for (CObject * obj : this->store.grid.at(x, y))
+            {
+                // An object registered in more tiles is rendered only from the first one in the range
+                if (std::max(obj->cells.x, range.x) == x && std::max(obj->cells.y, range.y) == y)
+                    obj->render(alpha);
+            }
+}
+
+void CObjectEventManager::update(const SInputFrame & input)
+{
+    CProfiler::CZone zone("update");
+
+    for (auto & player : this->store.players)
+        player.setInput(input.players[player.getTile() == PLAYER1 ? 0 : 1]);
+
+    // The chasing enemies share one search of the map, done before any of them moves
+    if (this->config.get(CONFIG_ENEMY_CHASE) && ! this->store.enemies.empty())
+    {
+        this->chaseTargets.clear();
+        for (auto & player : this->store.players)
+            this->chaseTargets.push_back(player.getTilePos());
+        this->flowField.update(this->tileSet, this->chaseTargets);
+    }
+
+    // Update each kind of objects, no objects get added in the meantime,
+    // so they stay on the same place in memory
+    this->store.forEachBucket([this] (auto & bucket)
+    {
+        for (auto & obj : bucket)
+        {
+            obj.previousPosition = obj.position;
+            obj.update(this->events, this->tileSet, this->store.grid);
+            this->store.grid.move(&obj);
+        }
+    });
 
     // Remove destroyed objects
-    for (auto obj : objToRemove)
-        this->objects.erase(obj);
+    this->store.removeFlagged();
 }
 
 void CObjectEventManager::manageEvents()
 {
     using namespace std;
-    list<Events::iterator> eventsToRemove;
+
+    CProfiler::CZone zone("manageEvents");
 
     // Create a door to enother level, once all enemies are dead
     if(this->aliveEnemies == 0 && this->mode == SINGLEPLAYER)
     {
-        auto pos = make_pair(mapWidth / 2, mapHeight / 2);
+        // The middle tile, moved off the pillars, which stand on the even tiles
+        auto pos = make_pair(this->tileSet.getWidth() / 2 | 1, this->tileSet.getHeight() / 2 | 1);
     
         // Replace a BREAKABLE with EMPTY, so the player can step into the door
-        if (this->tileSet[pos.second][pos.first]->tileType != EMPTY)
+        if (this->tileSet.at(pos.first, pos.second) != EMPTY)
             setTile(pos.first, pos.second, EMPTY);
 
-        addObject(new CDoor(pos, DOOR, this->renderer->getTexture(DOOR)));
+        this->store.add(this->store.doors, pos, DOOR, getTexture(DOOR));
         -- this->aliveEnemies;
     }
 
@@ -59,15 +141,15 @@ void CObjectEventManager::manageEvents()
     {
         this->alivePlayers --;
         this->endGame = true;
-
-        // Save the high score
-        if (loadData(config, "High score") < this->currentScore.first)
-            saveData(config, "High score", this->currentScore.first);
     }
 
     // Start next round in duel mode
     if (this->alivePlayers <= 1 && this->mode == DUEL)
     {
+        // The dead players have been removed already, the one left won the round
+        for (auto & player : this->store.players)
+            ++ (player.getTile() == PLAYER1 ? this->roundsWon.first : this->roundsWon.second);
+
         -- this->rounds;
         if (! this->rounds)
             this->endGame = true;
@@ -76,46 +158,51 @@ void CObjectEventManager::manageEvents()
     }
 
     // Iterate through events and carry them out
-    for (auto event = this->events.begin(); event != this->events.end(); ++ event)
+    for (auto & event : this->events)
     {
         pair<int,int> pos;
+        this->firedEvents |= 1u << event.type;
 
-        switch (get<0>(*event))
+        switch (event.type)
         {
         // Create a CBomb object
         case PLACE_BOMB:
-            addObject(new CBomb(get<1>(*event), BOMB, this->renderer->getTexture(BOMB), get<2>(*event)));
-            eventsToRemove.push_back(event);
+        {
+            const auto & data = get<SPlaceBomb>(event.data);
+            this->store.add(this->store.bombs, data.position, BOMB, getTexture(BOMB), data.size);
+            event.consumed = true;
             break;
+        }
 
         // Create a CExplosion object
         case PLACE_EXPLOSION:
-            pos = get<1>(*event);
+            pos = get<SPlaceExplosion>(event.data).position;
 
             // Replace a BREAKABLE with EMPTY, in case it was caught up in the explosion
-            if (this->tileSet[pos.second][pos.first]->tileType == BREAKABLE)
+            if (this->tileSet.at(pos.first, pos.second) == BREAKABLE)
             {
                 setTile(pos.first, pos.second, EMPTY);
 
                 // Possibly spawn a bonus at a given chance if a breakable was destroyed
-                if (this->bonusChance && randomInt(1, 100) % (100 / this->bonusChance) == 0)
-                    addObject(new CBonus(pos, BONUS, this->renderer->getTexture(BONUS)));
+                int bonusChance = this->config.get(CONFIG_BONUS_CHANCE);
+                if (bonusChance && this->random.between(1, 100) % (100 / bonusChance) == 0)
+                    this->store.add(this->store.bonuses, pos, BONUS, getTexture(BONUS), this->random, this->config);
             }
 
-            addObject(new CExplosion(pos, BOOM, this->renderer->getTexture(BOOM)));
-            eventsToRemove.push_back(event);
+            this->store.add(this->store.explosions, pos, BOOM, getTexture(BOOM));
+            event.consumed = true;
             break;
 
         // Decreases the number of surviving enemies
         case ENEMY_DEAD:
             -- this->aliveEnemies;
-            eventsToRemove.push_back(event);
+            event.consumed = true;
             break;
 
         // Decreases the number of surviving players
         case PLAYER_DEAD:
             -- this->alivePlayers;
-            eventsToRemove.push_back(event);
+            event.consumed = true;
             break;
 
         // Push the player to another level
@@ -129,8 +216,7 @@ void CObjectEventManager::manageEvents()
     }
 
     // Remove events that have been carried out
-    for (auto event : eventsToRemove)
-        this->events.erase(event);
+    this->events.removeConsumed();
 }
 
 void CObjectEventManager::startGame(const std::pair<Map, int> & map)
@@ -138,6 +224,8 @@ void CObjectEventManager::startGame(const std::pair<Map, int> & map)
     this->endGame = false;
     this->needsNewMap = false;
     this->currentScore = std::make_pair(map.second, 0);
+    this->roundsWon = std::make_pair(0, 0);
+    this->firedEvents = 0;
     loadFromMap(map.first);
 
     // Sets the game mode - the manageEvents() needs to know, so it can
@@ -147,79 +235,80 @@ void CObjectEventManager::startGame(const std::pair<Map, int> & map)
     else
     {
         this->mode = DUEL;
-        this->rounds = loadData(config,"Duel rounds");
+        this->rounds = this->config.get(CONFIG_DUEL_ROUNDS);
     }
 }
 
+void CObjectEventManager::invalidateBackground()
+{
+    if (! this->renderer)
+        return;
+
+    // A map of other dimensions needs a background of its own
+    if (! this->background || ! this->background->fits(this->tileSet.getWidth(), this->tileSet.getHeight()))
+        this->background.reset(new CRenderWindow::CBackground(this->tileSet.getWidth(), this->tileSet.getHeight()));
+    else
+        this->background->invalidate();
+}
+
+const std::pair<int,int> & CObjectEventManager::getScores() const
+{
+    return this->currentScore;
+}
+
+const std::pair<int,int> & CObjectEventManager::getRoundsWon() const
+{
+    return this->roundsWon;
+}
+
+const CTileGrid & CObjectEventManager::getTiles() const
+{
+    return this->tileSet;
+}
+
+const CObjectStore & CObjectEventManager::getStore() const
+{
+    return this->store;
+}
+
+uint32_t CObjectEventManager::takeFiredEvents()
+{
+    uint32_t fired = this->firedEvents;
+    this->firedEvents = 0;
+    return fired;
+}
+
 void CObjectEventManager::loadFromMap(const Map & map)
 {
     using namespace std;
 
-    // Clean up
-    this->tileSet.clear();
-    this->objects.clear();
+    // Clean up, the map gives the dimensions
+    int height = map.size();
+    int width = height ? map.front().size() : 0;
+    this->tileSet.reset(width, height);
+    this->flowField.invalidate();
+    invalidateBackground();
+    this->store.clear(width, height);
     this->events.clear();
     this->needsNewMap = false;
     this->alivePlayers = 0;
     this->aliveEnemies = 0;
 
-    for (int i = 0; i < mapHeight; ++ i)
+    for (int i = 0; i < height; ++ i)
     {
-        vector<unique_ptr<CTile>> tmp;
-        for (int j = 0; j < mapWidth; ++ j)
+        for (int j = 0; j < width; ++ j)
         {
-            // Set up tiles
-            if (map[i][j] == WALL)
-                tmp.push_back(unique_ptr<CTile>(new CTile(j, i, WALL, this->renderer->getTexture(WALL))));
+            // Set up tiles, everything else stands on grass
+            if (map[i][j] == WALL || map[i][j] == BREAKABLE)
+                this->tileSet.set(j, i, map[i][j]);
+            else if (map[i][j] != EMPTY)
+                addObject(map[i][j], make_pair(j, i));
 
-            else if (map[i][j] == BREAKABLE)
-                tmp.push_back(unique_ptr<CTile>(new CTile(j, i, BREAKABLE, this->renderer->getTexture(BREAKABLE))));
-
-            else
-                tmp.push_back(unique_ptr<CTile>(new CTile(j, i, EMPTY, this->renderer->getTexture(EMPTY))));
-
-            // Set up objects
-            if (map[i][j] == PLAYER1)
-            {
-                addObject(new CPlayer(make_pair(j, i), PLAYER1, this->renderer->getTexture(PLAYER1),
-                &this->currentScore.first, this->renderer->getText(PLAYER1_SCORE),
-                SDL_SCANCODE_W,
-                SDL_SCANCODE_S,
-                SDL_SCANCODE_A,
-                SDL_SCANCODE_D,
-                SDL_SCANCODE_SPACE));
-                ++ this->alivePlayers;
-            }
-            if (map[i][j] == PLAYER2)
-            {
-                addObject(new CPlayer(make_pair(j, i), PLAYER2, this->renderer->getTexture(PLAYER2),
-                &this->currentScore.second, this->renderer->getText(PLAYER2_SCORE),
-                SDL_SCANCODE_UP,
-                SDL_SCANCODE_DOWN,
-                SDL_SCANCODE_LEFT,
-                SDL_SCANCODE_RIGHT,
-                SDL_SCANCODE_RCTRL));
+            if (map[i][j] == PLAYER1 || map[i][j] == PLAYER2)
                 ++ this->alivePlayers;
-            }
             if (map[i][j] == ENEMY)
-            {
-                addObject(new CEnemy(make_pair(j, i), ENEMY, this->renderer->getTexture(ENEMY)));
                 ++ this->aliveEnemies;
-            }
-
-            if (map[i][j] == BOMB)
-                addObject(new CBomb(make_pair(j, i), BOMB, this->renderer->getTexture(BOMB)));
-
-            if (map[i][j] == BOOM)
-                addObject(new CExplosion(make_pair(j, i), BOOM, this->renderer->getTexture(BOOM)));
-
-            if (map[i][j] == DOOR)
-                addObject(new CDoor(make_pair(j, i), DOOR, this->renderer->getTexture(DOOR)));
-
-            if (map[i][j] == BONUS)
-                addObject(new CBonus(make_pair(j, i), BONUS, this->renderer->getTexture(BONUS)));
         }
-        this->tileSet.push_back(move(tmp));
     }
 }
 
@@ -228,35 +317,175 @@ const std::pair<Map, int> CObjectEventManager::saveIntoMap() const
     using namespace std;
 
     Map map;
+    map.reserve(this->tileSet.getHeight());
 
-    for (int i = 0; i < mapHeight; ++ i)
+    for (int i = 0; i < this->tileSet.getHeight(); ++ i)
     {
         vector<ETileType> tmp;
-        for (int j = 0; j < mapWidth; ++ j)
-            tmp.push_back(this->tileSet[i][j]->tileType);
+        tmp.reserve(this->tileSet.getWidth());
+        for (int j = 0; j < this->tileSet.getWidth(); ++ j)
+            tmp.push_back(this->tileSet.at(j, i));
 
-        map.push_back(tmp);
+        map.push_back(move(tmp));
     }
-    for (auto obj : this->objects)
+    // Players are visited last, so they can't get overwritten by other objects
+    this->store.forEachBucket([&] (auto & bucket)
     {
-        auto pos = obj->getTilePos();
-        map[pos.second][pos.first] = obj->getTile();
-    }
+        for (auto & obj : bucket)
+        {
+            auto pos = obj.getTilePos();
+            map[pos.second][pos.first] = obj.getTile();
+        }
+    });
 
     return make_pair(map, this->currentScore.first);
 }
 
-void CObjectEventManager::addEvent(const EEvent & event, const std::pair<int,int> & position, const int & num, CObject * obj)
+void CObjectEventManager::snapshot(CSnapshot & snapshot) const
+{
+    snapshot.begin();
+
+    snapshot.write(static_cast<uint8_t>(this->mode));
+    snapshot.write(this->needsNewMap);
+    snapshot.write(this->endGame);
+    snapshot.write(this->currentScore.first);
+    snapshot.write(this->currentScore.second);
+    snapshot.write(this->roundsWon.first);
+    snapshot.write(this->roundsWon.second);
+    snapshot.write(this->alivePlayers);
+    snapshot.write(this->aliveEnemies);
+    snapshot.write(this->rounds);
+    this->tileSet.save(snapshot);
+
+    // Each object starts with its tile type, so the right kind can be constructed again
+    uint32_t count = 0;
+    this->store.forEachBucket([&] (auto & bucket) { count += bucket.size(); });
+    snapshot.write(count);
+
+    this->store.forEachBucket([&] (auto & bucket)
+    {
+        for (auto & obj : bucket)
+        {
+            snapshot.write(static_cast<uint8_t>(obj.getTile()));
+            obj.save(snapshot);
+        }
+    });
+
+    this->events.save(snapshot);
+
+    // The generator goes last, constructing the objects again draws from it
+    this->random.save(snapshot);
+}
+
+void CObjectEventManager::restore(CSnapshot & snapshot)
 {
-    this->events.push_back(Event(event, position, num, obj));
+    using namespace std;
+
+    snapshot.rewind();
+
+    auto mode = static_cast<EGameMode>(snapshot.read<uint8_t>());
+    if (mode != SINGLEPLAYER && mode != DUEL)
+        throw invalid_argument("The snapshot has an unknown game mode");
+
+    this->mode = mode;
+    this->needsNewMap = snapshot.read<bool>();
+    this->endGame = snapshot.read<bool>();
+    this->currentScore.first = snapshot.read<int>();
+    this->currentScore.second = snapshot.read<int>();
+    this->roundsWon.first = snapshot.read<int>();
+    this->roundsWon.second = snapshot.read<int>();
+    this->alivePlayers = snapshot.read<int>();
+    this->aliveEnemies = snapshot.read<int>();
+    this->rounds = snapshot.read<int>();
+
+    this->tileSet.load(snapshot);
+    this->flowField.invalidate();
+    invalidateBackground();
+    this->store.clear(this->tileSet.getWidth(), this->tileSet.getHeight());
+
+    uint32_t count = snapshot.read<uint32_t>();
+    for (uint32_t i = 0; i < count; ++ i)
+    {
+        auto tile = static_cast<ETileType>(snapshot.read<uint8_t>());
+        if (tile <= BREAKABLE || tile > ETileType_MAX)
+            throw invalid_argument("The snapshot contains an unknown object");
+
+        // The object is constructed anywhere and then moved where it was
+        CObject * obj = addObject(tile, make_pair(0, 0));
+        obj->load(snapshot);
+        this->store.grid.move(obj);
+    }
+
+    this->events.load(snapshot);
+    this->random.load(snapshot);
+
+    if (! snapshot.finished())
+        throw invalid_argument("The snapshot is corrupted");
 }
 
-void CObjectEventManager::addObject(CObject * obj)
+CObject * CObjectEventManager::addObject(const ETileType & tile, const std::pair<int,int> & position)
 {
-    this->objects.push_front(std::shared_ptr<CObject>(obj));
+    using namespace std;
+
+    switch (tile)
+    {
+    case PLAYER1:
+        this->store.add(this->store.players, position, PLAYER1, getTexture(PLAYER1),
+        &this->currentScore.first, getText(PLAYER1_SCORE));
+        return &this->store.players.back();
+
+    case PLAYER2:
+        this->store.add(this->store.players, position, PLAYER2, getTexture(PLAYER2),
+        &this->currentScore.second, getText(PLAYER2_SCORE));
+        return &this->store.players.back();
+
+    case ENEMY:
+        this->store.add(this->store.enemies, position, ENEMY, getTexture(ENEMY), this->random,
+        this->config.get(CONFIG_ENEMY_CHASE) ? &this->flowField : nullptr);
+        return &this->store.enemies.back();
+
+    case BOMB:
+        this->store.add(this->store.bombs, position, BOMB, getTexture(BOMB));
+        return &this->store.bombs.back();
+
+    case BOOM:
+        this->store.add(this->store.explosions, position, BOOM, getTexture(BOOM));
+        return &this->store.explosions.back();
+
+    case DOOR:
+        this->store.add(this->store.doors, position, DOOR, getTexture(DOOR));
+        return &this->store.doors.back();
+
+    case BONUS:
+        this->store.add(this->store.bonuses, position, BONUS, getTexture(BONUS), this->random, this->config);
+        return &this->store.bonuses.back();
+
+    default:
+        throw invalid_argument("Tile type "s.append(to_string(tile)).append(" is not an object"));
+    }
 }
 
 void CObjectEventManager::setTile(const int & x, const int & y, const ETileType & tileType)
 {
-    this->tileSet[y][x].reset(new CTile(x, y, tileType, this->renderer->getTexture(tileType)));
+    this->tileSet.set(x, y, tileType);
+    this->flowField.invalidate();
+
+    if (this->background)
+        this->background->invalidate(x, y);
+}
+
+std::shared_ptr<CRenderWindow::CTexture> CObjectEventManager::getTexture(const ETileType & tile) const
+{
+    if (! this->renderer)
+        return nullptr;
+
+    return this->renderer->getTexture(tile);
+}
+
+std::shared_ptr<CRenderWindow::CText> CObjectEventManager::getText(const ETextType & textType) const
+{
+    if (! this->renderer)
+        return nullptr;
+
+    return this->renderer->getText(textType);
 }
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "CObjectStore.hpp"
+
+void CObjectStore::clear(const int & width, const int & height)
+{
+    forEachBucket([] (auto & bucket) { bucket.clear(); });
+    this->grid.reset(width, height);
+}
+
+void CObjectStore::reserve(const int & bombs, const int & explosions, const int & bonuses)
+{
+    this->bombs.reserve(bombs);
+    this->explosions.reserve(explosions);
+    this->bonuses.reserve(bonuses);
+}
+
+void CObjectStore::removeFlagged()
+{
+    forEachBucket([this] (auto & bucket) { sweep(bucket); });
+}
\ No newline at end of file
@@ -4,88 +4,76 @@ CPlayer::CPlayer(const std::pair<int,int> & position,
                  const ETileType & tile,
                  const std::shared_ptr<CRenderWindow::CTexture> & texture,
                  int * score,
-                 const std::shared_ptr<CRenderWindow::CText> & textSource,
-                 const SDL_Scancode & up,
-                 const SDL_Scancode & down,
-                 const SDL_Scancode & left,
-                 const SDL_Scancode & right,
-                 const SDL_Scancode & bomb)
+                 const std::shared_ptr<CRenderWindow::CText> & textSource)
 : CObject(position, tile, texture),
-  up(up),
-  down(down),
-  left(left),
-  right(right),
-  bomb(bomb),
+  input(0),
   placingBomb(false),
   speed(playerSpeed),
   bombSize(1),
   score(score, textSource)
 {}
 
-void CPlayer::update(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CPlayer::setInput(const uint8_t & input) { this->input = input; }
+
+int CPlayer::getBombSize() const { return this->bombSize; }
+
+int CPlayer::getSpeed() const { return this->speed; }
+
+void CPlayer::update(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
     using namespace std;
 
-    render();
     move(tileSet);
-    createEvents(events, tileSet, objects);
-
-    // Render score on screen, each player on different coordinations
-    if (this->tile == PLAYER1)
-        this->score.render(make_pair(0,0));
-    else
-        this->score.render(make_pair(mapWidth * tileWidth - (tileWidth / 2), 0));
-
-    list<Events::iterator> eventsToRemove;
+    createEvents(events, tileSet, grid);
 
     if (! this->toRemove)   // So points wouldn't get added to a dead player or when a player kills itself
-        for (auto event = events.begin(); event != events.end(); ++ event)
+        for (auto & event : events)
         {
+            if (event.consumed)
+                continue;
+
             // Add points to the score
-            if (get<0>(*event) == POINTS)
+            if (event.type == POINTS)
             {
-                this->score += get<2>(*event);
-                eventsToRemove.push_back(event);
+                this->score += get<SPoints>(event.data).points;
+                event.consumed = true;
             }
             // Gain a boost from bonus events
-            if (get<0>(*event) == GET_BONUS && get<3>(*event) == this)
+            if (event.type == GET_BONUS && get<SGetBonus>(event.data).player == this->tile)
             {
-                if (get<1>(*event).first == MEGABOMBS)
-                    this->bombSize = 1 + get<1>(*event).second;
+                const auto & bonus = get<SGetBonus>(event.data);
+
+                if (bonus.bonus == MEGABOMBS)
+                    this->bombSize = 1 + bonus.strength;
 
-                if (get<1>(*event).first == SPEED)
-                    this->speed = playerSpeed + get<1>(*event).second;
+                if (bonus.bonus == SPEED)
+                    this->speed = playerSpeed + bonus.strength;
 
-                eventsToRemove.push_back(event);
+                event.consumed = true;
             }
         }
-
-    // Remove events that have been carried out
-    for (auto event : eventsToRemove)
-        events.erase(event);
 }
 
-void CPlayer::createEvents(Events & events, const TileSet & tileSet, const std::list<std::shared_ptr<CObject>> & objects)
+void CPlayer::createEvents(CEventQueue & events, const CTileGrid & tileSet, const CSpatialGrid & grid)
 {
     using std::make_pair;
 
     // Create a bomb on players coordinates
-    const uint8_t * currentKeyStates = SDL_GetKeyboardState(nullptr);
-    if (! placingBomb && currentKeyStates[this->bomb])
+    if (! placingBomb && (this->input & INPUT_BOMB))
     {
         this->placingBomb = true;
-        events.emplace_back(PLACE_BOMB, getTilePos(), this->bombSize, this);
+        events.push(PLACE_BOMB, SPlaceBomb{getTilePos(), this->bombSize});
     }
     // Make sure to place only one bomb per key press
-    else if (placingBomb && ! currentKeyStates[this->bomb])
+    else if (placingBomb && ! (this->input & INPUT_BOMB))
         this->placingBomb = false;
 
     // Flag itself to get removed
-    if (objectCollision(objects, BOOM) || objectCollision(objects, ENEMY))
+    if (objectCollision(grid, BOOM) || objectCollision(grid, ENEMY))
     {
         this->toRemove = true;
-        events.emplace_back(PLAYER_DEAD, make_pair(0,0), 0, this);
-        events.emplace_back(POINTS, make_pair(0,0), 1, nullptr);
+        events.push(PLAYER_DEAD, SPlayerDead{this->tile});
+        events.push(POINTS, SPoints{1});
     }
 }
 
@@ -97,29 +85,60 @@ std::pair<int,int> CPlayer::getTilePos() const
     return std::make_pair(x, y);
 }
 
-void CPlayer::move(const TileSet & tileSet)
+void CPlayer::renderScore() const
+{
+    using std::make_pair;
+
+    // Render score on screen, each player on different coordinations
+    if (this->tile == PLAYER1)
+        this->score.render(make_pair(0,0));
+    else
+        this->score.render(make_pair(screenWidth - (tileWidth / 2), 0));
+}
+
+void CPlayer::save(CSnapshot & snapshot) const
+{
+    CObject::save(snapshot);
+    snapshot.write(this->placingBomb);
+    snapshot.write(this->speed);
+    snapshot.write(this->bombSize);
+}
+
+void CPlayer::load(CSnapshot & snapshot)
+{
+    CObject::load(snapshot);
+    this->placingBomb = snapshot.read<bool>();
+    this->speed = snapshot.read<int>();
+    this->bombSize = snapshot.read<int>();
+}
+
+void CPlayer::move(const CTileGrid & tileSet)
 {
     int dirX = 0;
     int dirY = 0;
 
-    // Move according to the key pressed
-    const uint8_t * currentKeyStates = SDL_GetKeyboardState(nullptr);
-    if (currentKeyStates[this->up] && !currentKeyStates[this->down])
+    // Move according to the input
+    bool up = this->input & INPUT_UP;
+    bool down = this->input & INPUT_DOWN;
+    bool left = this->input & INPUT_LEFT;
+    bool right = this->input & INPUT_RIGHT;
+
+    if (up && ! down)
     {
         dirY = -1;
         changePos(this->position.first, this->position.second - this->speed);
     }
-    if (currentKeyStates[this->down] && ! currentKeyStates[this->up])
+    if (down && ! up)
     {
         dirY = 1;
         changePos(this->position.first, this->position.second + this->speed);
     }
-    if (currentKeyStates[this->left] && ! currentKeyStates[this->right])
+    if (left && ! right)
     {
         dirX = -1;
         changePos(this->position.first - this->speed, this->position.second);
     }
-    if (currentKeyStates[this->right] && ! currentKeyStates[this->left])
+    if (right && ! left)
     {
         dirX = 1;
         changePos(this->position.first + this->speed, this->position.second);
@@ -127,11 +146,13 @@ void CPlayer::move(const TileSet & tileSet)
 
     setCollisionBox();
 
-    // Move back in case it collided with a wall
-    if (this->box.x < 0 || this->box.x > screenWidth - tileWidth || wallCollision(tileSet, upWall, downWall, leftWall, rightWall))
+    // Move back in case it collided with a wall or left the map, which can be larger than the window
+    int maxX = (tileSet.getWidth() - 1) * tileWidth;
+    int maxY = (tileSet.getHeight() - 1) * tileWidth;
+    if (this->box.x < 0 || this->box.x > maxX || wallCollision(tileSet, upWall, downWall, leftWall, rightWall))
         this->position.first -= this->speed * dirX;
 
-    if (this->box.y < 0 || this->box.y > screenHeight - tileWidth || wallCollision(tileSet, upWall, downWall, leftWall, rightWall))
+    if (this->box.y < 0 || this->box.y > maxY || wallCollision(tileSet, upWall, downWall, leftWall, rightWall))
         this->position.second -= this->speed * dirY;
 }
 
@@ -0,0 +1,122 @@
+#include "CProfiler.hpp"
+
+thread_local CProfiler * CProfiler::active = nullptr;
+
+CProfiler::CZone::CZone(const char * name)
+: profiler(CProfiler::active),
+  name(name),
+  start(this->profiler ? CProfiler::now() : 0)
+{}
+
+CProfiler::CZone::~CZone()
+{
+    if (this->profiler)
+        this->profiler->push(SRecord{this->name, this->start, CProfiler::now(), this->profiler->frame});
+}
+
+CProfiler::CProfiler(const std::string & traceFile, const uint32_t & captureFrames)
+: records(new SRecord[capacity]),
+  head(0),
+  traceFile(traceFile),
+  captureFrames(captureFrames),
+  frame(0),
+  frameStart(0),
+  slowFrame(0),
+  capturing(false)
+{}
+
+CProfiler::~CProfiler()
+{
+    if (CProfiler::active == this)
+        detach();
+}
+
+void CProfiler::attach() { CProfiler::active = this; }
+
+void CProfiler::detach() { CProfiler::active = nullptr; }
+
+void CProfiler::beginFrame()
+{
+    ++ this->frame;
+    this->frameStart = now();
+}
+
+void CProfiler::endFrame()
+{
+    using namespace std;
+
+    int64_t frameEnd = now();
+    push(SRecord{"frame", this->frameStart, frameEnd, this->frame});
+
+    if (! this->capturing && frameEnd - this->frameStart > (int64_t)frameDelay * 1000000)
+    {
+        this->capturing = true;
+        this->slowFrame = this->frame;
+    }
+
+    if (this->capturing && this->frame >= this->slowFrame + this->captureFrames)
+    {
+        this->capturing = false;
+
+        // The capture goes next to the trace file - trace.json -> trace-frame123.json
+        string path = this->traceFile;
+        size_t extension = path.rfind(".json");
+        if (extension != string::npos && extension + 5 == path.size())
+            path.erase(extension);
+
+        uint32_t from = this->slowFrame > this->captureFrames ? this->slowFrame - this->captureFrames : 0;
+        write(path + "-frame" + to_string(this->slowFrame) + ".json", from, this->frame);
+    }
+}
+
+void CProfiler::save() const { write(this->traceFile, 0, this->frame); }
+
+int64_t CProfiler::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void CProfiler::push(const SRecord & record)
+{
+    uint64_t index = this->head.load(std::memory_order_relaxed);
+    this->records[index & (capacity - 1)] = record;
+    this->head.store(index + 1, std::memory_order_release);
+}
+
+void CProfiler::write(const std::string & filePath, const uint32_t & from, const uint32_t & to) const
+{
+    using namespace std;
+
+    ofstream file(filePath);
+    if (! file.is_open())
+        throw FileException("Failed to open the file");
+
+    // The records still kept, from the oldest one
+    uint64_t end = this->head.load(memory_order_acquire);
+    uint64_t begin = end > capacity ? end - capacity : 0;
+
+    // Chrome expects the times in microseconds, relative to the earliest start - the records are pushed
+    // when the zones end, so an outer zone starts before the zones nested in it, which come first
+    int64_t origin = begin < end ? this->records[begin & (capacity - 1)].start : 0;
+    for (uint64_t i = begin; i < end; ++ i)
+        origin = min(origin, this->records[i & (capacity - 1)].start);
+    bool first = true;
+
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (uint64_t i = begin; i < end; ++ i)
+    {
+        const SRecord & record = this->records[i & (capacity - 1)];
+        if (record.frame < from || record.frame > to)
+            continue;
+
+        file << (first ? "\n" : ",\n") << "{\"name\": \"" << record.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": "
+             << (record.start - origin) / 1000.0 << ", \"dur\": " << (record.end - record.start) / 1000.0
+             << ", \"args\": {\"frame\": " << record.frame << "}}";
+        first = false;
+    }
+    file << "\n]}" << endl;
+
+    if (! file.good())
+        throw FileException("Failed to write into the file");
+}
\ No newline at end of file
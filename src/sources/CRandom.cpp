@@ -0,0 +1,76 @@
+#include "CRandom.hpp"
+
+CRandom::CRandom(const uint64_t & seed)
+{
+    this->seed(seed);
+}
+
+void CRandom::seed(const uint64_t & seed)
+{
+    this->seedValue = seed;
+
+    // Only a random seed needs the operating system, it's printed and has to fit into the configuration file
+    if (! this->seedValue)
+    {
+        std::random_device device;
+        this->seedValue = 1 + (((uint64_t)device() << 32) | device()) % maxSeed;
+    }
+
+    // Spread the seed over the whole state with splitmix64, the state must not be all zeros
+    uint64_t x = this->seedValue;
+    for (auto & part : this->state)
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        part = z ^ (z >> 31);
+    }
+}
+
+uint64_t CRandom::getSeed() const { return this->seedValue; }
+
+uint64_t CRandom::next()
+{
+    auto rotate = [] (const uint64_t & x, const int & k) { return (x << k) | (x >> (64 - k)); };
+
+    uint64_t result = rotate(this->state[1] * 5, 7) * 9;
+    uint64_t t = this->state[1] << 17;
+
+    this->state[2] ^= this->state[0];
+    this->state[3] ^= this->state[1];
+    this->state[1] ^= this->state[2];
+    this->state[0] ^= this->state[3];
+    this->state[2] ^= t;
+    this->state[3] = rotate(this->state[3], 45);
+
+    return result;
+}
+
+int CRandom::between(const int & from, const int & to)
+{
+    // Scale 32 random bits to the range by a multiplication,
+    // the few values which would make some results more likely are drawn again
+    uint32_t range = (uint32_t)((int64_t)to - from + 1);
+    uint64_t m = (next() >> 32) * range;
+
+    if ((uint32_t)m < range)
+    {
+        uint32_t threshold = - range % range;
+        while ((uint32_t)m < threshold)
+            m = (next() >> 32) * range;
+    }
+
+    return from + (int)(m >> 32);
+}
+
+void CRandom::save(CSnapshot & snapshot) const
+{
+    snapshot.write(this->state);
+    snapshot.write(this->seedValue);
+}
+
+void CRandom::load(CSnapshot & snapshot)
+{
+    snapshot.readBytes(this->state, sizeof(this->state));
+    this->seedValue = snapshot.read<uint64_t>();
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "CRenderWindow.hpp"
+
+CRenderWindow::CRenderQueue::CRenderQueue()
+: origin({0, 0})
+{
+    for (auto & layer : this->layers)
+        layer.reserve(1024);
+
+    this->vertices.reserve(4096);
+    this->indices.reserve(6144);
+}
+
+void CRenderWindow::CRenderQueue::push(SDL_Texture * texture, const ERenderLayer & layer,
+                                       const SDL_FRect & source, const SDL_Rect & target)
+{
+    const SDL_Color white = {255, 255, 255, 255};
+    float left = target.x + this->origin.x, top = target.y + this->origin.y;
+    float right = left + target.w, bottom = top + target.h;
+
+    this->layers[layer].push_back(SSprite{texture, {
+        {{left, top},     white, {source.x,            source.y}},
+        {{right, top},    white, {source.x + source.w, source.y}},
+        {{left, bottom},  white, {source.x,            source.y + source.h}},
+        {{right, bottom}, white, {source.x + source.w, source.y + source.h}}
+    }});
+}
+
+void CRenderWindow::CRenderQueue::setOrigin(const SDL_Point & origin) { this->origin = origin; }
+
+SDL_Point CRenderWindow::CRenderQueue::getOrigin() const { return this->origin; }
+
+void CRenderWindow::CRenderQueue::flush()
+{
+    SDL_Texture * current = nullptr;
+
+    for (auto & layer : this->layers)
+    {
+        for (auto & sprite : layer)
+        {
+            // A texture switch ends the batch
+            if (sprite.texture != current)
+            {
+                submit(current);
+                current = sprite.texture;
+            }
+
+            int first = this->vertices.size();
+            this->vertices.insert(this->vertices.end(), sprite.vertices, sprite.vertices + 4);
+
+            for (int index : {0, 1, 2, 2, 1, 3})
+                this->indices.push_back(first + index);
+        }
+        layer.clear();
+    }
+
+    submit(current);
+}
+
+void CRenderWindow::CRenderQueue::submit(SDL_Texture * texture)
+{
+    if (! this->vertices.empty())
+        SDL_RenderGeometry(renderer, texture, this->vertices.data(), this->vertices.size(),
+                           this->indices.data(), this->indices.size());
+
+    this->vertices.clear();
+    this->indices.clear();
+}
\ No newline at end of file
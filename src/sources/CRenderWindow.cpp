@@ -1,12 +1,47 @@
 #include "CRenderWindow.hpp"
 
 SDL_Renderer * CRenderWindow::renderer = nullptr;
+CRenderWindow::CRenderQueue CRenderWindow::queue;
+
+// Tile textures, in the order in which they are packed into the atlas
+static const std::tuple<ETileType, const char *, ERenderLayer> sprites[] = {
+    {EMPTY,     "assets/grass.png",          LAYER_TILES},
+    {WALL,      "assets/wall.png",           LAYER_TILES},
+    {BREAKABLE, "assets/breakable-wood.png", LAYER_TILES},
+    {DOOR,      "assets/door.png",           LAYER_ITEMS},
+    {BOMB,      "assets/bomb.png",           LAYER_BOMBS},
+    {BOOM,      "assets/boom.png",           LAYER_EXPLOSIONS},
+    {BONUS,     "assets/bonus.png",          LAYER_ITEMS},
+    {PLAYER1,   "assets/player1.png",        LAYER_CHARACTERS},
+    {PLAYER2,   "assets/player2.png",        LAYER_CHARACTERS},
+    {ENEMY,     "assets/enemy.png",          LAYER_CHARACTERS}
+};
+static const int spriteSize = 32;
+
+// UI textures with their dimensions
+static const std::tuple<EUIType, const char *, int, int> UIImages[] = {
+    {UI_BACKGROUND, "assets/UI-Background.png", 128, 128},
+    {UI_NEW_GAME,   "assets/UI-NewGame.png",    66,  15},
+    {UI_LOAD,       "assets/UI-Load.png",       66,  15},
+    {UI_DUEL,       "assets/UI-Duel.png",       66,  15},
+    {UI_EXIT,       "assets/UI-Exit.png",       66,  15}
+};
+
+// Texts with their colours, all of them share one font
+static const char * const fontPath = "./assets/PixelEmulator.ttf";
+static const int fontSize = 32;
+static const std::tuple<ETextType, SDL_Color> texts[] = {
+    {PLAYER1_SCORE, {172,50,50,255}},
+    {PLAYER2_SCORE, {34,175,175,255}},
+    {HIGH_SCORE,    {255,170,0,255}}
+};
 
 CRenderWindow::CRenderWindow(const char * title, const int & width, const int & height)
 {
     using namespace std;
 
     this->window = nullptr;
+    this->atlas = nullptr;
     this->window = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_SHOWN);
     
     if (! this->window)
@@ -17,18 +52,16 @@ CRenderWindow::~CRenderWindow()
 {
     // Pre delete all textures, otherwise they would get destroyed after CRenderWindow
     // and their destruction wouldn't work properly
-    for (auto & tile : this->tiles)
-        SDL_DestroyTexture(tile.second->texture);
+    // The tile textures share the atlas
+    if (this->atlas)
+        SDL_DestroyTexture(this->atlas);
 
     for (auto & texture : this->UI)
         SDL_DestroyTexture(texture.second->texture);
 
-    // Pre delete all text textures and their fonts
+    // Pre delete all text textures, their font is closed right after rasterising
     for (auto & text : this->text)
-    {
-        SDL_DestroyTexture(text.second->textTexture);
-        TTF_CloseFont(text.second->font);
-    }
+        SDL_DestroyTexture(text.second->atlas);
 
     if (this->renderer)
         SDL_DestroyRenderer(this->renderer);
@@ -41,10 +74,61 @@ CRenderWindow::~CRenderWindow()
 
 void CRenderWindow::startRender()
 {
-    this->renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    using namespace std::chrono;
+
+    this->renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
     SDL_SetRenderDrawColor(this->renderer, 0, 0, 0, 0);
-    this->loadTextures();
-    this->loadTexts();
+
+    // The pack must outlive the assets, they point into it
+    auto start = steady_clock::now();
+    std::unique_ptr<CAssetPack> pack;
+    SDecodedAssets assets;
+    try
+    {
+        pack.reset(new CAssetPack(assetPack));
+        if (pack->getSources() != assetSources())
+            throw FileException("The asset pack was built from other assets");
+        readAssetPack(*pack, assets);
+    }
+    catch (const FileException &)
+    {
+        // Without a usable pack the assets get decoded
+        assets.clear();
+        pack.reset();
+        decodeAssets(assets);
+    }
+    auto decoded = steady_clock::now();
+
+    this->loadTextures(assets);
+    this->loadTexts(assets);
+    auto uploaded = steady_clock::now();
+
+    this->startupTimes.decode = duration<double, std::milli>(decoded - start).count();
+    this->startupTimes.upload = duration<double, std::milli>(uploaded - decoded).count();
+    this->startupTimes.fromPack = pack != nullptr;
+}
+
+void CRenderWindow::buildAssetPack(const std::string & filePath)
+{
+    using namespace std;
+
+    SDecodedAssets assets;
+    decodeAssets(assets);
+
+    vector<CAssetPack::SAsset> packed;
+    for (size_t i = 0; i < size(sprites); ++ i)
+        packed.push_back({ASSET_SPRITE, get<0>(sprites[i]), assets.sprites[i], {}});
+    for (size_t i = 0; i < size(UIImages); ++ i)
+        packed.push_back({ASSET_UI, get<0>(UIImages[i]), assets.UI[i], {}});
+    for (size_t i = 0; i < size(texts); ++ i)
+        packed.push_back({ASSET_TEXT, get<0>(texts[i]), assets.texts[i], vector<SDL_FRect>(assets.glyphs[i].begin(), assets.glyphs[i].end())});
+
+    CAssetPack::write(filePath, packed, assetSources());
+}
+
+CRenderWindow::SStartupTimes CRenderWindow::getStartupTimes() const
+{
+    return this->startupTimes;
 }
 
 std::shared_ptr<CRenderWindow::CTexture> CRenderWindow::getTexture(const ETileType & tile) const
@@ -71,39 +155,169 @@ void CRenderWindow::display()
 {
     // SDL_RenderDrawPoint is used as a bug fix for a bug built in SDL2, which occurs while rendering text
     // The screen would otherwise become blank, if a new text message was to render
+    queue.flush();
     SDL_RenderDrawPoint(renderer, 0, 0);
     SDL_RenderPresent(this->renderer);
 }
 
-void CRenderWindow::loadTextures()
+void CRenderWindow::setView(const SDL_Rect & world, const SDL_Rect & screen)
+{
+    queue.flush();
+    queue.setOrigin({screen.x - world.x, screen.y - world.y});
+    SDL_RenderSetClipRect(this->renderer, &screen);
+}
+
+void CRenderWindow::resetView()
+{
+    queue.flush();
+    queue.setOrigin({0, 0});
+    SDL_RenderSetClipRect(this->renderer, nullptr);
+}
+
+CRenderWindow::SDecodedAssets::~SDecodedAssets()
 {
-    using std::shared_ptr;
+    this->clear();
+}
 
-    // Tile textures
-    this->tiles.emplace(EMPTY,      shared_ptr<CTexture>(new CTexture("assets/grass.png", 32, 32)));
-    this->tiles.emplace(WALL,       shared_ptr<CTexture>(new CTexture("assets/wall.png", 32, 32)));
-    this->tiles.emplace(BREAKABLE,  shared_ptr<CTexture>(new CTexture("assets/breakable-wood.png", 32, 32)));
-    this->tiles.emplace(DOOR,       shared_ptr<CTexture>(new CTexture("assets/door.png", 32, 32)));
-    this->tiles.emplace(BOMB,       shared_ptr<CTexture>(new CTexture("assets/bomb.png", 32, 32)));
-    this->tiles.emplace(BOOM,       shared_ptr<CTexture>(new CTexture("assets/boom.png", 32, 32)));
-    this->tiles.emplace(BONUS,      shared_ptr<CTexture>(new CTexture("assets/bonus.png", 32, 32)));
-    this->tiles.emplace(PLAYER1,    shared_ptr<CTexture>(new CTexture("assets/player1.png", 32, 32)));
-    this->tiles.emplace(PLAYER2,    shared_ptr<CTexture>(new CTexture("assets/player2.png", 32, 32)));
-    this->tiles.emplace(ENEMY,      shared_ptr<CTexture>(new CTexture("assets/enemy.png", 32, 32)));
+void CRenderWindow::SDecodedAssets::clear()
+{
+    for (auto surfaces : {&this->sprites, &this->UI, &this->texts})
+    {
+        for (auto surface : *surfaces)
+            if (surface)
+                SDL_FreeSurface(surface);
+        surfaces->clear();
+    }
+    this->glyphs.clear();
+    this->errors.clear();
+}
+
+void CRenderWindow::readAssetPack(const CAssetPack & pack, SDecodedAssets & assets)
+{
+    using namespace std;
+
+    // Every surface is stored right away, so the assets free it even when a later one is missing
+    for (auto & sprite : sprites)
+        assets.sprites.push_back(pack.image(ASSET_SPRITE, get<0>(sprite)));
+    for (auto & image : UIImages)
+        assets.UI.push_back(pack.image(ASSET_UI, get<0>(image)));
+
+    for (auto & text : texts)
+    {
+        assets.texts.push_back(pack.image(ASSET_TEXT, get<0>(text)));
+
+        vector<SDL_FRect> glyphs = pack.glyphs(ASSET_TEXT, get<0>(text));
+        if (glyphs.size() != CText::TGlyphs().size())
+            throw FileException("The asset pack holds glyphs of other characters");
+        assets.glyphs.emplace_back();
+        copy(glyphs.begin(), glyphs.end(), assets.glyphs.back().begin());
+    }
+}
+
+uint64_t CRenderWindow::assetSources()
+{
+    using namespace std;
+
+    vector<string> filePaths;
+    for (auto & sprite : sprites)
+        filePaths.push_back(get<1>(sprite));
+    for (auto & image : UIImages)
+        filePaths.push_back(get<1>(image));
+    filePaths.push_back(fontPath);
+
+    return CAssetPack::fingerprint(filePaths);
+}
+
+void CRenderWindow::decodeAssets(SDecodedAssets & assets)
+{
+    using namespace std;
+
+    assets.sprites.assign(size(sprites), nullptr);
+    assets.UI.assign(size(UIImages), nullptr);
+    assets.texts.assign(size(texts), nullptr);
+    assets.glyphs.resize(size(texts));
+    assets.errors.resize(size(sprites) + size(UIImages) + 1);
+
+    // Each task gets its own slot for the result and for the error, so the tasks share nothing
+    CThreadPool pool(min<size_t>(thread::hardware_concurrency(), assets.errors.size()));
+    auto decode = [](const char * filePath, SDL_Surface * & surface, string & error)
+    {
+        surface = IMG_Load(filePath);
+        if (! surface)
+            error = "SDL texture loading error: "s.append(SDL_GetError());
+    };
+
+    for (size_t i = 0; i < size(sprites); ++ i)
+        pool.submit([&, i]{ decode(get<1>(sprites[i]), assets.sprites[i], assets.errors[i]); });
+
+    for (size_t i = 0; i < size(UIImages); ++ i)
+        pool.submit([&, i]{ decode(get<1>(UIImages[i]), assets.UI[i], assets.errors[size(sprites) + i]); });
+
+    // All of the texts use the same font, it gets opened once and rasterised in every colour
+    pool.submit([&assets]
+    {
+        string & error = assets.errors.back();
+        TTF_Font * font = TTF_OpenFont(fontPath, fontSize);
+        if (! font)
+        {
+            error = "TTF load error: "s.append(TTF_GetError());
+            return;
+        }
+
+        try
+        {
+            for (size_t i = 0; i < size(texts); ++ i)
+                assets.texts[i] = CText::rasterise(font, get<1>(texts[i]), assets.glyphs[i]);
+        }
+        catch (const runtime_error & err)
+        {
+            error = err.what();
+        }
+        TTF_CloseFont(font);
+    });
+
+    pool.wait();
+
+    for (auto & error : assets.errors)
+        if (! error.empty())
+            throw runtime_error(error);
+}
+
+void CRenderWindow::loadTextures(const SDecodedAssets & assets)
+{
+    using namespace std;
+
+    SDL_Surface * atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, spriteSize * size(sprites), spriteSize, 32, SDL_PIXELFORMAT_RGBA32);
+    if (! atlasSurface)
+        throw runtime_error("SDL texture atlas creation error: "s.append(SDL_GetError()));
+
+    // Copy the sprites next to each other, including their transparency
+    for (size_t i = 0; i < size(sprites); ++ i)
+    {
+        SDL_Rect target = {(int)i * spriteSize, 0, spriteSize, spriteSize};
+        SDL_SetSurfaceBlendMode(assets.sprites[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(assets.sprites[i], nullptr, atlasSurface, &target);
+    }
+
+    this->atlas = SDL_CreateTextureFromSurface(this->renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (! this->atlas)
+        throw runtime_error("SDL texture atlas creation error: "s.append(SDL_GetError()));
+    SDL_SetTextureBlendMode(this->atlas, SDL_BLENDMODE_BLEND);
+
+    for (size_t i = 0; i < size(sprites); ++ i)
+        this->tiles.emplace(get<0>(sprites[i]), shared_ptr<CTexture>(new CTexture(this->atlas,
+                            {(int)i * spriteSize, 0, spriteSize, spriteSize}, get<2>(sprites[i]))));
 
     // UI textures
-    this->UI.emplace(UI_BACKGROUND, shared_ptr<CTexture>(new CTexture("assets/UI-Background.png", 128, 128)));
-    this->UI.emplace(UI_NEW_GAME,   shared_ptr<CTexture>(new CTexture("assets/UI-NewGame.png", 66, 15)));
-    this->UI.emplace(UI_LOAD,       shared_ptr<CTexture>(new CTexture("assets/UI-Load.png", 66, 15)));
-    this->UI.emplace(UI_DUEL,       shared_ptr<CTexture>(new CTexture("assets/UI-Duel.png", 66, 15)));
-    this->UI.emplace(UI_EXIT,       shared_ptr<CTexture>(new CTexture("assets/UI-Exit.png", 66, 15)));
+    for (size_t i = 0; i < size(UIImages); ++ i)
+        this->UI.emplace(get<0>(UIImages[i]), shared_ptr<CTexture>(new CTexture(assets.UI[i], get<2>(UIImages[i]), get<3>(UIImages[i]))));
 }
 
-void CRenderWindow::loadTexts()
+void CRenderWindow::loadTexts(const SDecodedAssets & assets)
 {
-    using std::shared_ptr;
+    using namespace std;
 
-    this->text.emplace(PLAYER1_SCORE, shared_ptr<CText>(new CText("./assets/PixelEmulator.ttf", {172,50,50,255}, 32)));
-    this->text.emplace(PLAYER2_SCORE, shared_ptr<CText>(new CText("./assets/PixelEmulator.ttf", {34,175,175,255}, 32)));
-    this->text.emplace(HIGH_SCORE,    shared_ptr<CText>(new CText("./assets/PixelEmulator.ttf", {255,170,0,255}, 32)));
+    for (size_t i = 0; i < size(texts); ++ i)
+        this->text.emplace(get<0>(texts[i]), shared_ptr<CText>(new CText(assets.texts[i], assets.glyphs[i])));
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "CReplay.hpp"
+
+void CReplay::begin(const CObjectEventManager & manager, const CConfig & config)
+{
+    this->settings.begin();
+    config.save(this->settings);
+    manager.snapshot(this->start);
+
+    this->runs.clear();
+    this->ticks = 0;
+    this->finalHash = 0;
+}
+
+void CReplay::record(const SInputFrame & input)
+{
+    if (this->runs.empty() || this->runs.back().input != input || this->runs.back().length == UINT16_MAX)
+        this->runs.push_back(SRun{input, 0});
+
+    ++ this->runs.back().length;
+    ++ this->ticks;
+}
+
+void CReplay::end(const CObjectEventManager & manager)
+{
+    manager.snapshot(this->scratch);
+    this->finalHash = this->scratch.hash();
+}
+
+void CReplay::play(CObjectEventManager & manager, CConfig & config)
+{
+    this->settings.rewind();
+    config.load(this->settings);
+    manager.restore(this->start);
+
+    this->run = 0;
+    this->played = 0;
+}
+
+bool CReplay::next(SInputFrame & input)
+{
+    // Move on to the next run, once the current one was played
+    while (this->run < this->runs.size() && this->played == this->runs[this->run].length)
+    {
+        ++ this->run;
+        this->played = 0;
+    }
+
+    if (this->run == this->runs.size())
+        return false;
+
+    input = this->runs[this->run].input;
+    ++ this->played;
+    return true;
+}
+
+bool CReplay::check(const CObjectEventManager & manager) const
+{
+    manager.snapshot(this->scratch);
+    return this->scratch.hash() == this->finalHash;
+}
+
+uint32_t CReplay::getTicks() const { return this->ticks; }
+
+void CReplay::save(const std::string & filePath) const
+{
+    CSnapshot file;
+
+    file.begin(magic, version);
+    file.writeSnapshot(this->settings);
+    file.writeSnapshot(this->start);
+    file.write(this->ticks);
+    file.write(this->finalHash);
+    file.write(static_cast<uint32_t>(this->runs.size()));
+    file.writeBytes(this->runs.data(), this->runs.size() * sizeof(SRun));
+
+    file.save(filePath);
+}
+
+void CReplay::load(const std::string & filePath)
+{
+    CSnapshot file;
+
+    file.load(filePath);
+    file.rewind(magic, version);
+    file.readSnapshot(this->settings);
+    file.readSnapshot(this->start);
+    this->ticks = file.read<uint32_t>();
+    this->finalHash = file.read<uint64_t>();
+
+    // The runs can't be larger than the file
+    uint32_t count = file.read<uint32_t>();
+    if (count * sizeof(SRun) > file.getData().size())
+        throw std::invalid_argument("The replay is corrupted");
+
+    this->runs.resize(count);
+    file.readBytes(this->runs.data(), this->runs.size() * sizeof(SRun));
+
+    if (! file.finished())
+        throw std::invalid_argument("The replay is corrupted");
+
+    this->run = 0;
+    this->played = 0;
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <CScore.hpp>
 
+#include <charconv>
+
 CScore::CScore(int * num, const std::shared_ptr<CRenderWindow::CText> & textSource)
 : score(num),
   text(textSource)
@@ -12,5 +14,8 @@ void CScore::operator += (const int & num)
 
 void CScore::render(const std::pair<int,int> & position) const
 {
-    this->text->render(std::to_string(*this->score), position);
+    // The digits are written into a buffer on the stack, drawing the score never allocates
+    char digits[16];
+    char * end = std::to_chars(digits, digits + sizeof(digits), *this->score).ptr;
+    this->text->render(std::string_view(digits, end - digits), position);
 }
\ No newline at end of file
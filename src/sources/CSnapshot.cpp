@@ -0,0 +1,105 @@
+#include "CSnapshot.hpp"
+
+void CSnapshot::begin(const uint32_t & formatMagic, const uint16_t & formatVersion)
+{
+    this->data.clear();
+    this->offset = 0;
+    write(formatMagic);
+    write(formatVersion);
+}
+
+void CSnapshot::rewind(const uint32_t & formatMagic, const uint16_t & formatVersion)
+{
+    using std::invalid_argument;
+
+    this->offset = 0;
+    if (this->data.size() < sizeof(formatMagic) + sizeof(formatVersion) || read<uint32_t>() != formatMagic)
+        throw invalid_argument("The data is not a snapshot of the game");
+
+    if (read<uint16_t>() != formatVersion)
+        throw invalid_argument("The snapshot was made by a different version of the game");
+}
+
+void CSnapshot::writeBytes(const void * data, const size_t & size)
+{
+    auto bytes = static_cast<const uint8_t *>(data);
+    this->data.insert(this->data.end(), bytes, bytes + size);
+}
+
+void CSnapshot::readBytes(void * data, const size_t & size)
+{
+    if (this->offset + size > this->data.size())
+        throw std::invalid_argument("The snapshot is corrupted");
+
+    std::memcpy(data, this->data.data() + this->offset, size);
+    this->offset += size;
+}
+
+void CSnapshot::writeSnapshot(const CSnapshot & other)
+{
+    write(static_cast<uint32_t>(other.data.size()));
+    writeBytes(other.data.data(), other.data.size());
+}
+
+void CSnapshot::readSnapshot(CSnapshot & other)
+{
+    uint32_t size = read<uint32_t>();
+    if (this->offset + size > this->data.size())
+        throw std::invalid_argument("The snapshot is corrupted");
+
+    other.data.assign(this->data.begin() + this->offset, this->data.begin() + this->offset + size);
+    other.offset = 0;
+    this->offset += size;
+}
+
+uint64_t CSnapshot::hash() const
+{
+    uint64_t hash = 0xcbf29ce484222325;
+
+    for (auto byte : this->data)
+    {
+        hash ^= byte;
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+bool CSnapshot::finished() const
+{
+    return this->offset == this->data.size();
+}
+
+void CSnapshot::save(const std::string & filePath) const
+{
+    std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+
+    if (! out.is_open())
+        throw FileException("Failed to open the file");
+
+    out.write(reinterpret_cast<const char *>(this->data.data()), this->data.size());
+    if (out.fail())
+        throw FileException("File could not be written");
+}
+
+void CSnapshot::load(const std::string & filePath)
+{
+    using namespace std;
+
+    ifstream in(filePath, ios::binary | ios::ate);
+
+    if (! in.is_open())
+        throw FileException("Failed to open the file");
+
+    this->data.resize(in.tellg());
+    this->offset = 0;
+    in.seekg(0);
+    in.read(reinterpret_cast<char *>(this->data.data()), this->data.size());
+    if (in.fail())
+        throw FileException("File could not be read");
+}
+
+const std::vector<uint8_t> & CSnapshot::getData() const
+{
+    return this->data;
+}
\ No newline at end of file
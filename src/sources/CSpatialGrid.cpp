@@ -0,0 +1,89 @@
+#include "CSpatialGrid.hpp"
+#include "CObject.hpp"
+
+CSpatialGrid::CSpatialGrid(const int & width, const int & height)
+{
+    reset(width, height);
+}
+
+void CSpatialGrid::reset(const int & width, const int & height)
+{
+    this->width = width;
+    this->height = height;
+    this->grid.assign(width * height, std::vector<CObject *>());
+}
+
+void CSpatialGrid::insert(CObject * obj)
+{
+    obj->cells = cells(obj->box);
+    add(obj, obj->cells);
+}
+
+void CSpatialGrid::remove(CObject * obj)
+{
+    erase(obj, obj->cells);
+}
+
+void CSpatialGrid::move(CObject * obj)
+{
+    SDL_Rect range = cells(obj->box);
+
+    // The object stays in the same tiles, nothing to do
+    if (range.x == obj->cells.x && range.y == obj->cells.y && range.w == obj->cells.w && range.h == obj->cells.h)
+        return;
+
+    erase(obj, obj->cells);
+    obj->cells = range;
+    add(obj, obj->cells);
+}
+
+void CSpatialGrid::relocate(const CObject * from, CObject * to)
+{
+    for (int y = to->cells.y; y < to->cells.y + to->cells.h; ++ y)
+        for (int x = to->cells.x; x < to->cells.x + to->cells.w; ++ x)
+        {
+            auto & cell = this->grid[y * this->width + x];
+            std::replace(cell.begin(), cell.end(), const_cast<CObject *>(from), to);
+        }
+}
+
+SDL_Rect CSpatialGrid::cells(const SDL_Rect & box) const
+{
+    // The boxes overlap only when their right and bottom edges are strictly greater,
+    // so the last overlapped pixel is at x + w - 1
+    int fromX = std::clamp(box.x / tileWidth, 0, this->width - 1);
+    int fromY = std::clamp(box.y / tileWidth, 0, this->height - 1);
+    int toX = std::clamp((box.x + box.w - 1) / tileWidth, 0, this->width - 1);
+    int toY = std::clamp((box.y + box.h - 1) / tileWidth, 0, this->height - 1);
+
+    return SDL_Rect{fromX, fromY, toX - fromX + 1, toY - fromY + 1};
+}
+
+const std::vector<CObject *> & CSpatialGrid::at(const int & x, const int & y) const
+{
+    return this->grid[y * this->width + x];
+}
+
+void CSpatialGrid::erase(CObject * obj, const SDL_Rect & range)
+{
+    for (int y = range.y; y < range.y + range.h; ++ y)
+        for (int x = range.x; x < range.x + range.w; ++ x)
+        {
+            auto & cell = this->grid[y * this->width + x];
+            auto it = std::find(cell.begin(), cell.end(), obj);
+
+            // The order in a tile doesn't matter, so swap the object with the last one
+            if (it != cell.end())
+            {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+}
+
+void CSpatialGrid::add(CObject * obj, const SDL_Rect & range)
+{
+    for (int y = range.y; y < range.y + range.h; ++ y)
+        for (int x = range.x; x < range.x + range.w; ++ x)
+            this->grid[y * this->width + x].push_back(obj);
+}
\ No newline at end of file
@@ -1,56 +1,75 @@
 #include "CRenderWindow.hpp"
 
 CRenderWindow::CText::CText()
-: font(nullptr),
-  color({0,0,0,0}),
-  textTexture(nullptr)
+: atlas(nullptr),
+  glyphs()
 {}
 
-CRenderWindow::CText::CText(const char * filePath, const SDL_Color & color, const int & size)
-: font(nullptr),
-  color(color),
-  textTexture(nullptr),
-  oldText("")
+CRenderWindow::CText::CText(SDL_Surface * atlasSurface, const TGlyphs & glyphs)
+: atlas(nullptr),
+  glyphs(glyphs)
 {
     using namespace std;
 
-    this->font = TTF_OpenFont(filePath, size);
-    if (! this->font)
-        throw runtime_error("TTF load error: "s.append(TTF_GetError()));
+    if (! renderer)
+        throw runtime_error("TTF glyph atlas creation error: Renderer not initialized");
+
+    this->atlas = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    if (! this->atlas)
+        throw runtime_error("TTF glyph atlas creation error: "s.append(SDL_GetError()));
 }
 
-void CRenderWindow::CText::renderNew(const std::string & text)
+SDL_Surface * CRenderWindow::CText::rasterise(TTF_Font * font, const SDL_Color & color, TGlyphs & glyphs)
 {
     using namespace std;
 
-    if (this->textTexture)
-        SDL_DestroyTexture(this->textTexture);
+    // Rasterise every character on its own, the widest one decides the size of a cell in the atlas
+    array<SDL_Surface *, lastGlyph - firstGlyph + 1> surfaces;
+    int cellWidth = 1, cellHeight = max(TTF_FontHeight(font), 1);
+    for (char c = firstGlyph; c <= lastGlyph; ++ c)
+    {
+        SDL_Surface * & surface = surfaces[c - firstGlyph];
+        surface = TTF_RenderGlyph_Shaded(font, c, color, {0,0,0,100});
+        if (surface)
+        {
+            cellWidth = max(cellWidth, surface->w);
+            cellHeight = max(cellHeight, surface->h);
+        }
+    }
+
+    glyphs = TGlyphs();
+    SDL_Surface * atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, cellWidth * surfaces.size(), cellHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlasSurface)
+        for (size_t i = 0; i < surfaces.size(); ++ i)
+        {
+            // A character missing in the font stays blank
+            if (! surfaces[i])
+                continue;
 
-    SDL_Surface * surface = TTF_RenderText_Shaded(this->font, text.c_str(), this->color, {0,0,0,100});
-    if (! surface)
-        throw runtime_error("TTF text rendering from surface error: "s.append(TTF_GetError()));
+            SDL_Rect target = {(int)i * cellWidth, 0, surfaces[i]->w, surfaces[i]->h};
+            SDL_BlitSurface(surfaces[i], nullptr, atlasSurface, &target);
+            glyphs[i] = {(float)target.x / atlasSurface->w, 0, (float)target.w / atlasSurface->w, (float)target.h / cellHeight};
+        }
 
-    this->textTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (! this->textTexture)
-        throw runtime_error("TTF texture creation from a surface error: "s.append(TTF_GetError()));
+    for (auto surface : surfaces)
+        if (surface)
+            SDL_FreeSurface(surface);
 
-    SDL_FreeSurface(surface);
-    this->oldText = text;
+    if (! atlasSurface)
+        throw runtime_error("TTF glyph atlas creation error: "s.append(SDL_GetError()));
+    return atlasSurface;
 }
 
-void CRenderWindow::CText::render(const std::string & text, const std::pair<int,int> & position,
-                                  const int & width, const int & height)
+void CRenderWindow::CText::render(std::string_view text, const std::pair<int,int> & position,
+                                  const int & width, const int & height) const
 {
-    // Creates a new texture, when the text changes
-    if (this->oldText != text)
-        renderNew(text);
-
-    // Sets up the position on screen where the text will render
-    SDL_Rect dest;
-    dest.x = position.first;
-    dest.y = position.second;
-    dest.w = text.size() * width;
-    dest.h = height;
-
-    SDL_RenderCopy(renderer, textTexture, NULL, &dest);
+    // Every character gets a cell of the same size, the space only moves the next one
+    for (size_t i = 0; i < text.size(); ++ i)
+    {
+        if (text[i] <= firstGlyph || text[i] > lastGlyph)
+            continue;
+
+        SDL_Rect dest = {position.first + (int)i * width, position.second, width, height};
+        queue.push(this->atlas, LAYER_TEXT, this->glyphs[text[i] - firstGlyph], dest);
+    }
 }
\ No newline at end of file
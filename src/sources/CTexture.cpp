@@ -4,30 +4,48 @@ CRenderWindow::CTexture::CTexture()
 : texture(nullptr)
 {}
 
-CRenderWindow::CTexture::CTexture(const char * filePath, const int & w, const int & h)
+CRenderWindow::CTexture::CTexture(SDL_Surface * image, const int & w, const int & h, const ERenderLayer & layer)
 : width(w),
   height(h),
-  texture(nullptr)
+  texture(nullptr),
+  region({0, 0, w, h}),
+  textureWidth(w),
+  textureHeight(h),
+  layer(layer)
 {
     using namespace std;
 
     if (! renderer)
         throw runtime_error("SDL texture loading error: Renderer not initialized");
 
-    this->texture = IMG_LoadTexture(renderer, filePath);
+    this->texture = SDL_CreateTextureFromSurface(renderer, image);
 
     if (! this->texture)
         throw runtime_error("SDL texture loading error: "s.append(SDL_GetError()));
+
+    SDL_QueryTexture(this->texture, nullptr, nullptr, &this->textureWidth, &this->textureHeight);
+}
+
+CRenderWindow::CTexture::CTexture(SDL_Texture * atlas, const SDL_Rect & region, const ERenderLayer & layer)
+: width(region.w),
+  height(region.h),
+  texture(atlas),
+  region(region),
+  textureWidth(region.w),
+  textureHeight(region.h),
+  layer(layer)
+{
+    SDL_QueryTexture(this->texture, nullptr, nullptr, &this->textureWidth, &this->textureHeight);
 }
 
 void CRenderWindow::CTexture::render(const int & srcX, const int & srcY,
                                      const int & tarX, const int & tarY, const int & tarH, const int & tarW) const
 {
-    SDL_Rect source;
-    source.x = srcX;
-    source.y = srcY;
-    source.w = this->width;
-    source.h = this->height;
+    SDL_FRect source;
+    source.x = (float)(this->region.x + srcX) / this->textureWidth;
+    source.y = (float)(this->region.y + srcY) / this->textureHeight;
+    source.w = (float)this->width / this->textureWidth;
+    source.h = (float)this->height / this->textureHeight;
     
     SDL_Rect target;
     target.x = tarX;
@@ -35,5 +53,5 @@ void CRenderWindow::CTexture::render(const int & srcX, const int & srcY,
     target.w = tarH;
     target.h = tarW;
 
-    SDL_RenderCopy(renderer, this->texture, &source, &target);
-}
+    queue.push(this->texture, this->layer, source, target);
+}
\ No newline at end of file
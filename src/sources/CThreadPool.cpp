@@ -0,0 +1,67 @@
+#include "CThreadPool.hpp"
+
+CThreadPool::CThreadPool(const size_t & threads)
+: running(0),
+  stopping(false)
+{
+    size_t count = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < count; ++ i)
+        this->workers.emplace_back(&CThreadPool::work, this);
+}
+
+CThreadPool::~CThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->taskReady.notify_all();
+
+    for (auto & worker : this->workers)
+        worker.join();
+}
+
+void CThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->tasks.push(std::move(task));
+    }
+    this->taskReady.notify_one();
+}
+
+void CThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->allDone.wait(lock, [this] { return this->tasks.empty() && ! this->running; });
+}
+
+size_t CThreadPool::size() const { return this->workers.size(); }
+
+void CThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->taskReady.wait(lock, [this] { return this->stopping || ! this->tasks.empty(); });
+
+            // The remaining tasks are finished before stopping
+            if (this->tasks.empty())
+                return;
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop();
+            ++ this->running;
+        }
+
+        task();
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        -- this->running;
+        if (this->tasks.empty() && ! this->running)
+            this->allDone.notify_all();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "CTileGrid.hpp"
+
+CTileGrid::CTileGrid(const int & width, const int & height)
+{
+    reset(width, height);
+}
+
+void CTileGrid::reset(const int & width, const int & height)
+{
+    this->width = width;
+    this->height = height;
+    this->tiles.assign(width * height, EMPTY);
+}
+
+ETileType CTileGrid::at(const int & x, const int & y) const
+{
+    return static_cast<ETileType>(this->tiles[y * this->width + x]);
+}
+
+void CTileGrid::set(const int & x, const int & y, const ETileType & tileType)
+{
+    this->tiles[y * this->width + x] = tileType;
+}
+
+bool CTileGrid::isSolid(const int & x, const int & y) const
+{
+    uint8_t tile = this->tiles[y * this->width + x];
+    return tile == WALL || tile == BREAKABLE;
+}
+
+SDL_Rect CTileGrid::cells(const SDL_Rect & box) const
+{
+    // The last overlapped pixel is at x + w - 1, see CObject::checkCollision()
+    int fromX = std::clamp(box.x / tileWidth, 0, this->width - 1);
+    int fromY = std::clamp(box.y / tileWidth, 0, this->height - 1);
+    int toX = std::clamp((box.x + box.w - 1) / tileWidth, 0, this->width - 1);
+    int toY = std::clamp((box.y + box.h - 1) / tileWidth, 0, this->height - 1);
+
+    return SDL_Rect{fromX, fromY, toX - fromX + 1, toY - fromY + 1};
+}
+
+SDL_Rect CTileGrid::box(const int & x, const int & y)
+{
+    return SDL_Rect{x * tileWidth, y * tileWidth, tileWidth, tileWidth};
+}
+
+void CTileGrid::save(CSnapshot & snapshot) const
+{
+    snapshot.write(this->width);
+    snapshot.write(this->height);
+    snapshot.writeBytes(this->tiles.data(), this->tiles.size());
+}
+
+void CTileGrid::load(CSnapshot & snapshot)
+{
+    int width = snapshot.read<int>();
+    int height = snapshot.read<int>();
+
+    if (width < 1 || height < 1 || width > maxMapSize || height > maxMapSize)
+        throw std::invalid_argument("The snapshot has a map of invalid dimensions");
+
+    reset(width, height);
+    snapshot.readBytes(this->tiles.data(), this->tiles.size());
+
+    // Objects aren't stored among the tiles, see CObjectEventManager::restore()
+    for (uint8_t tile : this->tiles)
+        if (tile != EMPTY && tile != WALL && tile != BREAKABLE)
+            throw std::invalid_argument("The snapshot contains an unknown tile");
+}
+
+int CTileGrid::getWidth() const { return this->width; }
+
+int CTileGrid::getHeight() const { return this->height; }
\ No newline at end of file
@@ -1,8 +1,9 @@
 #include "CUserInterface.hpp"
 
-CUserInterface::CUserInterface(const CRenderWindow * renderer)
+CUserInterface::CUserInterface(const CRenderWindow * renderer, const CConfig & config)
 : shown(true),
   highScore(0),
+  config(config),
   scalar(1)
 {
     using std::make_pair;
@@ -15,7 +16,8 @@ CUserInterface::CUserInterface(const CRenderWindow * renderer)
         this->scalar = 0.25;
 
     // Load the highscore
-    this->highScore = loadData(config, "High score");
+    this->highScore = config.get(CONFIG_HIGH_SCORE);
+    this->highScoreLabel = "HIGH SCORE: " + std::to_string(this->highScore);
     this->highScoreText = renderer->getText(HIGH_SCORE);
 
     // Get the dimensions of the background, scale them
@@ -62,7 +64,7 @@ void CUserInterface::render() const
     // Render everything when the UI is shown
     if (this->shown)
     {
-        this->highScoreText->render("HIGH SCORE: "s.append(to_string(this->highScore)), make_pair(tileWidth / 2, 0), 40 * this->scalar, 80 * this->scalar);
+        this->highScoreText->render(this->highScoreLabel, make_pair(tileWidth / 2, 0), 40 * this->scalar, 80 * this->scalar);
         for (auto & button : this->buttons)
             button->render();
     }
@@ -72,5 +74,11 @@ void CUserInterface::show()
 {
     this->shown = true;
     // Update the high score
-    this->highScore = loadData(config, "High score");
+    this->highScore = this->config.get(CONFIG_HIGH_SCORE);
+    this->highScoreLabel = "HIGH SCORE: " + std::to_string(this->highScore);
+}
+
+void CUserInterface::hide()
+{
+    this->shown = false;
 }
\ No newline at end of file
@@ -1,16 +1,5 @@
 #include "Utilities.hpp"
 
-int randomInt(const int & from, const int & to)
-{
-    using namespace std;
-
-    random_device device;
-    mt19937 engine(device());
-    uniform_int_distribution<mt19937::result_type> dist(from, to);
-
-    return dist(engine);
-}
-
 void trim(std::string & str, const std::string & charsToAvoid)
 {
     str.erase(0, str.find_first_not_of(charsToAvoid));
@@ -0,0 +1,305 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <charconv>
+
+#include "CObjectEventManager.hpp"
+#include "CRenderWindow.hpp"
+#include "CMap.hpp"
+#include "CRandom.hpp"
+#include "CConfig.hpp"
+#include "Utilities.hpp"
+#include "GameConstants.hpp"
+
+/**
+ * @brief The measured time of one benchmark
+ */
+struct SBenchmark
+{
+    std::string name;           /**< What was measured */
+    std::string params;         /**< The parameters as JSON object members, may be empty */
+    long long iterations;       /**< The number of operations in one timed batch */
+    double nsPerOp;             /**< The median time of one operation over the batches */
+    double minNsPerOp;          /**< The fastest time of one operation over the batches */
+    std::string skipped;        /**< Why the benchmark couldn't run, empty when it ran */
+};
+
+/**
+ * @brief An object that lets the benchmarks call the protected collision checks
+ */
+class CProbe final : public CObject
+{
+public:
+    CProbe(const std::pair<int,int> & position) : CObject(position, PLAYER1, nullptr) {}
+
+    using CObject::objectCollision;
+    using CObject::wallCollision;
+
+    /**
+     * @brief Moves the probe onto a tile
+     */
+    void moveTo(const std::pair<int,int> & tile)
+    {
+        changePos(scale(tile.first), scale(tile.second));
+        setCollisionBox();
+    }
+};
+
+// The results of the operations are added up here, so the compiler can't leave them out
+static volatile long long sink = 0;
+
+/**
+ * @brief Times an operation
+ * 
+ * The operation runs in batches, which are doubled until one takes at least 20 ms.
+ * Then 7 batches are timed and the median and the fastest one are reported
+ * 
+ * @param name what is measured
+ * @param params the parameters as JSON object members
+ * @param operation the operation, its result is kept so it doesn't get optimized away
+ * @return the measured time
+ */
+SBenchmark measure(const std::string & name, const std::string & params, const std::function<long long()> & operation)
+{
+    using namespace std;
+    using clock = chrono::steady_clock;
+
+    auto timeBatch = [&] (const long long & iterations)
+    {
+        long long sum = 0;
+        auto start = clock::now();
+        for (long long i = 0; i < iterations; ++ i)
+            sum += operation();
+        chrono::duration<double, nano> time = clock::now() - start;
+        sink = sink + sum;
+        return time.count();
+    };
+
+    long long iterations = 1;
+    while (timeBatch(iterations) < 20e6)
+        iterations *= 2;
+
+    vector<double> samples;
+    for (int i = 0; i < 7; ++ i)
+        samples.push_back(timeBatch(iterations) / iterations);
+    sort(samples.begin(), samples.end());
+
+    cerr << name << (params.empty() ? "" : " {" + params + "}") << ": " << samples[samples.size() / 2] << " ns" << endl;
+    return SBenchmark{name, params, iterations, samples[samples.size() / 2], samples.front(), ""};
+}
+
+/**
+ * @brief Escapes a string for JSON
+ */
+std::string escape(const std::string & text)
+{
+    std::string result;
+
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        if ((unsigned char)c < 0x20)
+            result += ' ';
+        else
+            result += c;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Writes the results as JSON
+ */
+void writeJSON(std::ostream & out, const CConfig & configuration, const std::vector<SBenchmark> & results)
+{
+    using namespace std;
+
+    out << "{\n  \"context\": {\"map_width\": " << configuration.get(CONFIG_MAP_WIDTH)
+        << ", \"map_height\": " << configuration.get(CONFIG_MAP_HEIGHT)
+        << ", \"tile_width\": " << tileWidth << ", \"tick_rate\": " << tickRate << "},\n  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++ i)
+    {
+        const SBenchmark & result = results[i];
+
+        out << "    {\"name\": \"" << escape(result.name) << "\", \"params\": {" << result.params << "}";
+        if (result.skipped.empty())
+            out << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.nsPerOp
+                << ", \"min_ns_per_op\": " << result.minNsPerOp;
+        else
+            out << ", \"skipped\": \"" << escape(result.skipped) << "\"";
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    out << "  ]\n}" << endl;
+}
+
+/**
+ * Measures the hot paths of the game and writes the results as JSON
+ *
+ * Usage: ./neprater-bench [output file]
+ *
+ * Without an output file the JSON goes to the standard output, the progress always goes to the error output.
+ * CText::render needs a window, on a machine without a display set SDL_VIDEODRIVER=dummy
+ */
+int main(int argc, char * args[])
+{
+    using namespace std;
+
+    vector<SBenchmark> results;
+    unique_ptr<CConfig> configuration;
+
+    try
+    {
+        configuration.reset(new CConfig());
+        const int mapWidth = configuration->get(CONFIG_MAP_WIDTH);
+        const int mapHeight = configuration->get(CONFIG_MAP_HEIGHT);
+        CRandom random(1);
+
+        // The free tiles of a generated map, the probes and objects are placed on them
+        CMap generated(DUEL, random, *configuration);
+        auto map = generated.getMap().first;
+        CTileGrid tiles(mapWidth, mapHeight);
+        vector<pair<int,int>> freeTiles;
+        for (int y = 0; y < mapHeight; ++ y)
+            for (int x = 0; x < mapWidth; ++ x)
+            {
+                if (map[y][x] == WALL || map[y][x] == BREAKABLE)
+                    tiles.set(x, y, map[y][x]);
+                else
+                    freeTiles.push_back(make_pair(x, y));
+            }
+
+        // Collisions with objects, the grid keeps the cost independent of the number of objects far away
+        for (int count : {16, 64, 256, 1024})
+        {
+            CSpatialGrid grid(mapWidth, mapHeight);
+            vector<CObject> objects;
+            objects.reserve(count);
+            for (int i = 0; i < count; ++ i)
+            {
+                objects.emplace_back(freeTiles[random.between(0, freeTiles.size() - 1)], BOOM, nullptr);
+                grid.insert(&objects.back());
+            }
+
+            CProbe probe(freeTiles.front());
+            size_t next = 0;
+            results.push_back(measure("CObject::objectCollision", "\"objects\": " + to_string(count), [&]
+            {
+                probe.moveTo(freeTiles[next++ % freeTiles.size()]);
+                return (long long)(probe.objectCollision(grid, BOOM) != nullptr);
+            }));
+        }
+
+        CProbe probe(freeTiles.front());
+        size_t next = 0;
+        results.push_back(measure("CObject::wallCollision", "", [&]
+        {
+            probe.moveTo(freeTiles[next++ % freeTiles.size()]);
+            return (long long)probe.wallCollision(tiles, 0.8, -0.1, 0.1, 0.1);
+        }));
+
+        // One time frame of a whole game, random keys are held like in the simulations
+        for (auto mode : {SINGLEPLAYER, DUEL})
+        {
+            CRandom gameRandom(2), keys(3);
+            CObjectEventManager manager(*configuration, gameRandom);
+            manager.startGame(CMap(mode, gameRandom, *configuration).getMap());
+
+            // The game starts again from the same state, whenever it ends
+            CSnapshot start;
+            manager.snapshot(start);
+            SInputFrame input{};
+            long long ticks = 0;
+
+            results.push_back(measure("CObjectEventManager::tick", mode == DUEL ? "\"mode\": \"duel\"" : "\"mode\": \"singleplayer\"", [&]
+            {
+                if (manager.endGame)
+                    manager.restore(start);
+                if (ticks++ % (tickRate / 3) == 0)
+                    input = SInputFrame{{(uint8_t)keys.between(0, 31), (uint8_t)keys.between(0, 31)}};
+
+                manager.update(input);
+                manager.manageEvents();
+                return (long long)manager.getStore().players.size();
+            }));
+        }
+
+        for (auto mode : {SINGLEPLAYER, DUEL})
+            results.push_back(measure("CMap::CMap", mode == DUEL ? "\"mode\": \"duel\"" : "\"mode\": \"singleplayer\"", [&]
+            {
+                return (long long)CMap(mode, random, *configuration).getMap().first[1][1];
+            }));
+
+        // Saving and loading go through a file of their own
+        const char * saveFile = "./bin/bench-map.txt";
+        CMap saved(SINGLEPLAYER, random, *configuration, saveFile);
+        results.push_back(measure("CMap::save", "", [&] { saved.save(); return 0LL; }));
+        results.push_back(measure("CMap::load", "", [&] { saved.load(); return (long long)saved.getMap().second; }));
+
+        results.push_back(measure("loadData", "\"kind\": \"number\"", [&]
+        {
+            return (long long)loadData(saveFile, "Score");
+        }));
+        results.push_back(measure("loadData", "\"kind\": \"map\"", [&]
+        {
+            return (long long)loadData(saveFile, "Map", true).str().size();
+        }));
+        remove(saveFile);
+    }
+    catch (const exception & err)
+    {
+        cerr << "\033[1;31mBENCHMARKS COULD NOT RUN:\033[0m" << endl;
+        cerr << err.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    // Rendering a text needs a window and the fonts
+    CRenderWindow * window = nullptr;
+    try
+    {
+        if (SDL_Init(SDL_INIT_VIDEO) < 0 || TTF_Init() == -1 || ! IMG_Init(IMG_INIT_PNG))
+            throw runtime_error("SDL initialization error: "s.append(SDL_GetError()));
+
+        window = new CRenderWindow("Benchmark", screenWidth, screenHeight);
+        window->startRender();
+        auto text = window->getText(PLAYER1_SCORE);
+
+        // The score changes every time, the rendered glyphs are drawn once in a while like in a frame
+        int score = 0;
+        results.push_back(measure("CText::render", "", [&]
+        {
+            char digits[16];
+            char * end = to_chars(digits, digits + sizeof(digits), score++).ptr;
+            text->render(string_view(digits, end - digits), make_pair(0, 0));
+            if (score % 64 == 0)
+                window->display();
+            return (long long)score;
+        }));
+    }
+    catch (const runtime_error & err)
+    {
+        results.push_back(SBenchmark{"CText::render", "", 0, 0, 0, err.what()});
+    }
+    delete window;
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+
+    if (argc > 1)
+    {
+        ofstream out(args[1]);
+        writeJSON(out, *configuration, results);
+    }
+    else
+        writeJSON(cout, *configuration, results);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -1,8 +1,47 @@
 #include "CGame.hpp"
 
+/**
+ * Usage: ./neprater [--record <replay file> | --replay <replay file>] [--profile <trace file>]
+ *
+ * --record writes every game into the replay file, --replay plays a recorded game back,
+ * --profile writes the phases of the last frames and of the slow ones as a Chrome trace
+ */
 int main(int argc, char * args[])
 {   
+    using namespace std;
+
+    string recordFile, replayFile, profileFile;
+
+    for (int i = 1; i < argc; ++ i)
+    {
+        string option = args[i];
+
+        if (option == "--record" && i + 1 < argc)
+            recordFile = args[++ i];
+        else if (option == "--replay" && i + 1 < argc)
+            replayFile = args[++ i];
+        else if (option == "--profile" && i + 1 < argc)
+            profileFile = args[++ i];
+        else
+        {
+            cout << "Usage: " << args[0] << " [--record <replay file> | --replay <replay file>] [--profile <trace file>]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (! recordFile.empty() && ! replayFile.empty())
+    {
+        cout << "A replay can't be recorded while another one is played" << endl;
+        return EXIT_FAILURE;
+    }
+
     CGame game("Bomberman");
+    if (! recordFile.empty())
+        game.recordInto(recordFile);
+    if (! replayFile.empty())
+        game.playReplay(replayFile);
+    if (! profileFile.empty())
+        game.profileInto(profileFile);
     game.run();
 
     return EXIT_SUCCESS;
@@ -0,0 +1,39 @@
+#include <iostream>
+#include <string>
+#include <stdexcept>
+
+#include "CRenderWindow.hpp"
+#include "GameConstants.hpp"
+
+/**
+ * Decodes all of the assets and writes them into the asset pack, which the game maps at startup
+ *
+ * Usage: ./neprater-pack [output file]
+ *
+ * The pack is written into ./assets/assets.pack by default, the game ignores it once the assets change
+ */
+int main(int argc, char * args[])
+{
+    using namespace std;
+
+    string filePath = argc > 1 ? args[1] : assetPack;
+    int result = 0;
+    try
+    {
+        if (! IMG_Init(IMG_INIT_PNG) || TTF_Init() == -1)
+            throw runtime_error("SDL initialization error: "s.append(SDL_GetError()));
+
+        CRenderWindow::buildAssetPack(filePath);
+        cout << "The assets were packed into " << filePath << endl;
+    }
+    catch (const runtime_error & err)
+    {
+        cout << "\033[1;31mTHE ASSETS COULD NOT BE PACKED:\033[0m" << endl;
+        cout << err.what() << endl;
+        result = 1;
+    }
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+
+#include "CObjectEventManager.hpp"
+#include "CMap.hpp"
+#include "CRandom.hpp"
+#include "CConfig.hpp"
+#include "CSnapshot.hpp"
+#include "CReplay.hpp"
+#include "CBot.hpp"
+#include "CThreadPool.hpp"
+#include "EGameMode.hpp"
+#include "GameConstants.hpp"
+
+/**
+ * Plays a recorded game as fast as possible and checks, that it ends in the recorded state
+ * 
+ * @param filePath the path to the replay file
+ * @return the exit code of the program
+ */
+int playReplay(const char * filePath)
+{
+    using namespace std;
+
+    CConfig configuration;
+    CRandom random;
+    CObjectEventManager manager(configuration, random);
+    CReplay replay;
+
+    replay.load(filePath);
+    replay.play(manager, configuration);
+
+    SInputFrame input;
+    auto start = chrono::steady_clock::now();
+    while (replay.next(input))
+        manager.tick(input);
+    chrono::duration<double> time = chrono::steady_clock::now() - start;
+
+    cout << "Replayed " << replay.getTicks() << " time frames in " << time.count() * 1000 << " ms ("
+         << replay.getTicks() / time.count() << " time frames per second)" << endl;
+
+    if (! replay.check(manager))
+    {
+        cout << "\033[1;31mTHE REPLAY DIVERGED FROM THE RECORDED GAME\033[0m" << endl;
+        return EXIT_FAILURE;
+    }
+
+    cout << "The replay ended in the recorded state" << endl;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Who plays the matches
+ */
+enum EPlayers
+{
+    PLAYERS_IDLE,       /**< Nobody presses anything */
+    PLAYERS_RANDOM,     /**< Random keys held for a while, like someone mashing the keyboard */
+    PLAYERS_BOT         /**< CBot plays for every player */
+};
+
+/**
+ * @brief The outcome of one match
+ */
+struct SMatchResult
+{
+    uint64_t seed = 0;                      /**< The seed the match started from */
+    int ticks = 0;                          /**< The number of simulated time frames */
+    bool finished = false;                  /**< The match ended before the time frame limit */
+    std::pair<int,int> scores;              /**< The scores of both players */
+    std::pair<int,int> roundsWon;           /**< The duel rounds won by both players */
+    size_t bombs = 0;                       /**< The most bombs on the map at once */
+    size_t explosions = 0;                  /**< The most explosions on the map at once */
+    size_t bonuses = 0;                     /**< The most bonuses on the map at once */
+    size_t snapshotSize = 0;                /**< The size of the snapshot of the final state */
+    std::chrono::nanoseconds snapshotTime;  /**< How long it took to take the snapshot */
+    std::chrono::nanoseconds restoreTime;   /**< How long it took to restore the snapshot */
+};
+
+/**
+ * Runs one match from start to end, everything it needs is its own,
+ * so any number of matches can run at once
+ *
+ * @param configuration the configuration, it is only read
+ * @param mode the game mode
+ * @param tickLimit the maximal number of time frames
+ * @param seed the seed of the match, 0 means a random one
+ * @param players who plays the match
+ * @return the outcome
+ */
+SMatchResult runMatch(const CConfig & configuration, const EGameMode & mode, const int & tickLimit,
+                      const uint64_t & seed, const EPlayers & players)
+{
+    using namespace std;
+
+    SMatchResult result;
+    CRandom random(seed);
+    CObjectEventManager manager(configuration, random);
+    manager.startGame(CMap(mode, random, configuration).getMap());
+    result.seed = random.getSeed();
+
+    // The players draw from their own generators, so they don't change the game's sequence
+    CRandom keys(result.seed * 2 + 1);
+    CBot bots[2] = {CBot(PLAYER1, result.seed * 2 + 1), CBot(PLAYER2, result.seed * 2 + 3)};
+    SInputFrame input{};
+
+    for (; result.ticks < tickLimit && ! manager.endGame; ++ result.ticks)
+    {
+        if (players == PLAYERS_RANDOM && result.ticks % (tickRate / 3) == 0)
+            input = SInputFrame{{(uint8_t)keys.between(0, 31), (uint8_t)keys.between(0, 31)}};
+
+        if (players == PLAYERS_BOT)
+            for (int i = 0; i < 2; ++ i)
+                input.players[i] = bots[i].think(manager);
+
+        manager.tick(input);
+    }
+
+    result.finished = manager.endGame;
+    result.scores = manager.getScores();
+    result.roundsWon = manager.getRoundsWon();
+
+    // Beyond the configured sizes the arrays grow during the match, the high-water marks show how to set them
+    const auto & store = manager.getStore();
+    result.bombs = store.bombs.highWaterMark();
+    result.explosions = store.explosions.highWaterMark();
+    result.bonuses = store.bonuses.highWaterMark();
+
+    // Take a snapshot of the final state and restore it, to see how long it takes
+    CSnapshot snapshot;
+    auto start = chrono::steady_clock::now();
+    manager.snapshot(snapshot);
+    auto middle = chrono::steady_clock::now();
+    manager.restore(snapshot);
+    result.snapshotTime = chrono::duration_cast<chrono::nanoseconds>(middle - start);
+    result.restoreTime = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - middle);
+    result.snapshotSize = snapshot.getData().size();
+
+    return result;
+}
+
+/**
+ * Runs matches without opening a window - nothing gets rendered, the game is only simulated
+ *
+ * Usage: ./neprater-sim [number of matches] [singleplayer|duel] [time frame limit per match] [idle|random|bot] [threads]
+ *        ./neprater-sim --replay <replay file>
+ *
+ * The matches run on a pool of threads, one for each core unless specified otherwise.
+ * Match i starts from the seed in the configuration file plus i, or from a random seed when it is 0.
+ * Every match prints its seed, so it can be run again on its own - with the same seed
+ * the output doesn't depend on the number of threads.
+ * A replay recorded by './neprater --record' is played back without a window
+ */
+int main(int argc, char * args[])
+{
+    using namespace std;
+
+    int matches = 100;
+    EGameMode mode = SINGLEPLAYER;
+    int tickLimit = tickRate * 60 * 5;
+    EPlayers players = PLAYERS_IDLE;
+    int threads = 0;
+
+    try
+    {
+        if (argc > 1 && string(args[1]) == "--replay")
+        {
+            if (argc != 3)
+                throw invalid_argument("Usage: "s.append(args[0]).append(" --replay <replay file>"));
+            return playReplay(args[2]);
+        }
+
+        if (argc > 1)
+            matches = stoi(args[1]);
+        if (argc > 2)
+            mode = string(args[2]) == "duel" ? DUEL : SINGLEPLAYER;
+        if (argc > 3)
+            tickLimit = stoi(args[3]);
+        if (argc > 4)
+            players = string(args[4]) == "bot" ? PLAYERS_BOT : string(args[4]) == "random" ? PLAYERS_RANDOM : PLAYERS_IDLE;
+        if (argc > 5)
+            threads = stoi(args[5]);
+
+        if (matches < 1 || tickLimit < 1 || threads < 0)
+            throw invalid_argument("The number of matches and the time frame limit must be positive");
+
+        CConfig configuration;
+        uint64_t seed = configuration.get(CONFIG_SEED);
+        vector<SMatchResult> results(matches);
+
+        auto start = chrono::steady_clock::now();
+        {
+            // Every match writes only its own result
+            CThreadPool pool(threads);
+            threads = pool.size();
+            for (int i = 0; i < matches; ++ i)
+                pool.submit([&, i] { results[i] = runMatch(configuration, mode, tickLimit, seed ? (seed - 1 + i) % CRandom::maxSeed + 1 : 0, players); });
+            pool.wait();
+        }
+        chrono::duration<double> time = chrono::steady_clock::now() - start;
+
+        long long totalTicks = 0;
+        int finished = 0;
+        long long scores[2] = {0, 0}, roundsWon[2] = {0, 0};
+        SMatchResult most;
+        most.snapshotTime = most.restoreTime = chrono::nanoseconds(0);
+
+        for (int i = 0; i < matches; ++ i)
+        {
+            const SMatchResult & result = results[i];
+
+            totalTicks += result.ticks;
+            finished += result.finished;
+            scores[0] += result.scores.first;
+            scores[1] += result.scores.second;
+            roundsWon[0] += result.roundsWon.first;
+            roundsWon[1] += result.roundsWon.second;
+            most.bombs = max(most.bombs, result.bombs);
+            most.explosions = max(most.explosions, result.explosions);
+            most.bonuses = max(most.bonuses, result.bonuses);
+            most.snapshotSize = max(most.snapshotSize, result.snapshotSize);
+            most.snapshotTime = max(most.snapshotTime, result.snapshotTime);
+            most.restoreTime = max(most.restoreTime, result.restoreTime);
+
+            cout << "Match " << i + 1 << " (seed " << result.seed << "): " << result.ticks << " time frames"
+                 << (result.finished ? ", finished" : ", reached the limit");
+            if (mode == SINGLEPLAYER)
+                cout << ", score " << result.scores.first << endl;
+            else
+                cout << ", rounds won " << result.roundsWon.first << ":" << result.roundsWon.second << endl;
+        }
+
+        cout << "Finished matches: " << finished << "/" << matches
+             << ", average length: " << totalTicks / matches << " time frames" << endl;
+        if (mode == SINGLEPLAYER)
+            cout << "Average score: " << (double)scores[0] / matches << endl;
+        else
+            cout << "Rounds won: player 1 " << roundsWon[0] << ", player 2 " << roundsWon[1] << endl;
+        cout << "Simulated " << totalTicks << " time frames in " << time.count() << " s on " << threads << " threads ("
+             << (long long)(totalTicks / time.count()) << " time frames per second)" << endl;
+        cout << "Object pools high-water marks (configured size): bombs " << most.bombs << " (" << configuration.get(CONFIG_POOL_BOMBS)
+             << "), explosions " << most.explosions << " (" << configuration.get(CONFIG_POOL_EXPLOSIONS)
+             << "), bonuses " << most.bonuses << " (" << configuration.get(CONFIG_POOL_BONUSES) << ")" << endl;
+        cout << "Largest snapshot: " << most.snapshotSize << " bytes, slowest snapshot: " << most.snapshotTime.count() / 1000.0
+             << " us, slowest restore: " << most.restoreTime.count() / 1000.0 << " us" << endl;
+    }
+    catch (const FileException & err)
+    {
+        cout << "\033[1;31mSIMULATION COULD NOT START DUE TO AN ERROR IN READING A FILE:\033[0m" << endl;
+        cout << err.what() << endl;
+        return EXIT_FAILURE;
+    }
+    catch (const invalid_argument & err)
+    {
+        cout << "\033[1;31mSIMULATION COULD NOT START DUE TO INVALID ARGUMENTS OR CONFIGURATION FILE:\033[0m" << endl;
+        cout << err.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
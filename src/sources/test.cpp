@@ -1,5 +1,9 @@
 #include <cassert>
 #include "CGame.hpp"
+#include "CBot.hpp"
+#include "CThreadPool.hpp"
+#include "CCamera.hpp"
+#include "CClock.hpp"
 
 using namespace std;
 
@@ -56,10 +60,30 @@ int main(int argc, char * args[])
     assert(loadData(config, "Another error label", true).str() == "Fix the error"s);
     saveData(config, "Another error label", stringstream(""));
 
-    CMap map1(SINGLEPLAYER, "./examples/map4.txt");
+    // Test the configuration loaded into memory
+    CConfig configuration;
+    assert(configuration.get(CONFIG_HIGH_SCORE) == 600);
+    assert(configuration.getText(CONFIG_SAVE_FILE) == "./examples/map4.txt"s);
+    assert(configuration.get(CONFIG_ENEMIES) == 5);
+    assert(configuration.get(CONFIG_BONUS_SPEED) == 2);
+    assert(configuration.get(CONFIG_POOL_EXPLOSIONS) == 256);
+    assert(configuration.get(CONFIG_MAP_WIDTH) == 23 && configuration.get(CONFIG_MAP_HEIGHT) == 15);
+    try
+    {
+        CConfig("some/nonexistent/file");
+        assert(false);
+    }
+    catch (const FileException & err)
+    {
+        assert(string_view(err.what()) == "Failed to open the file");
+    }
+
+    CRandom random(42);
+
+    CMap map1(SINGLEPLAYER, random, configuration, "./examples/map4.txt");
     map1.load(); // Should load with no error
 
-    CMap map2(SINGLEPLAYER, "./examples/map5.txt");
+    CMap map2(SINGLEPLAYER, random, configuration, "./examples/map5.txt");
     try
     {
         map2.load();
@@ -70,7 +94,7 @@ int main(int argc, char * args[])
         assert(string_view(err.what()) == "The map you are trying to load has invalid dimensions. Required width: 23, height: 15");
     }
 
-    CMap map3(SINGLEPLAYER, "./examples/map6.txt");
+    CMap map3(SINGLEPLAYER, random, configuration, "./examples/map6.txt");
     try
     {
         map3.load();
@@ -81,7 +105,7 @@ int main(int argc, char * args[])
         assert(string_view(err.what()) == "Unknown tile type loaded");
     }
 
-    CMap map4(SINGLEPLAYER, "./examples/map7.txt");
+    CMap map4(SINGLEPLAYER, random, configuration, "./examples/map7.txt");
     try
     {
         map4.load();
@@ -105,7 +129,7 @@ int main(int argc, char * args[])
     }
     saveData("./examples/map7.txt", "Map", stream);
 
-    CMap map5(SINGLEPLAYER, "./examples/map8.txt");
+    CMap map5(SINGLEPLAYER, random, configuration, "./examples/map8.txt");
     try
     {
         map5.load();
@@ -116,7 +140,7 @@ int main(int argc, char * args[])
         assert(string_view(err.what()) == "The map you are trying to load has invalid dimensions. Required width: 23, height: 15");
     }
 
-    CMap map6(SINGLEPLAYER, "./examples/map9.txt");
+    CMap map6(SINGLEPLAYER, random, configuration, "./examples/map9.txt");
     try
     {
         map6.save();
@@ -128,7 +152,7 @@ int main(int argc, char * args[])
     }
     remove("./examples/map9.txt");
 
-    CMap map7(SINGLEPLAYER);
+    CMap map7(SINGLEPLAYER, random, configuration);
     auto tmp1 = map7.getMap().first;
 
     int players1 = 0;
@@ -148,10 +172,10 @@ int main(int argc, char * args[])
         }
     }
     assert(players1 == 1);
-    assert(loadData(config, "Breakables") == breakables1);
-    assert(loadData(config, "Enemies") == enemies1);
+    assert(configuration.get(CONFIG_BREAKABLES) == breakables1);
+    assert(configuration.get(CONFIG_ENEMIES) == enemies1);
 
-    CMap map8(DUEL);
+    CMap map8(DUEL, random, configuration);
     auto tmp2 = map8.getMap().first;
 
     int players2 = 0;
@@ -171,9 +195,617 @@ int main(int argc, char * args[])
         }
     }
     assert(players2 == 2);
-    assert(loadData(config, "Breakables") == breakables2);
+    assert(configuration.get(CONFIG_BREAKABLES) == breakables2);
     assert(enemies2 == 0);
 
+    // The same seed generates the same map
+    CRandom random1(7), random2(7);
+    assert(CMap(SINGLEPLAYER, random1, configuration).getMap() == CMap(SINGLEPLAYER, random2, configuration).getMap());
+    assert(CMap(DUEL, random1, configuration).getMap() == CMap(DUEL, random2, configuration).getMap());
+
+    // Nothing is generated around the players, so they can always place a bomb and hide
+    for (int i = 0; i < 200; ++ i)
+    {
+        Map generated = CMap(i % 2 ? DUEL : SINGLEPLAYER, random1, configuration).getMap().first;
+        int breakables = 0;
+        for (int y = 0; y < configuration.get(CONFIG_MAP_HEIGHT); ++ y)
+            for (int x = 0; x < configuration.get(CONFIG_MAP_WIDTH); ++ x)
+            {
+                breakables += generated[y][x] == BREAKABLE;
+                if (generated[y][x] != PLAYER1 && generated[y][x] != PLAYER2)
+                    continue;
+                for (int v = y - 1; v <= y + 1; ++ v)
+                    for (int u = x - 1; u <= x + 1; ++ u)
+                        assert(generated[v][u] != BREAKABLE && generated[v][u] != ENEMY);
+            }
+        assert(breakables == configuration.get(CONFIG_BREAKABLES));
+    }
+
+    // A printed random seed can be put into the configuration file to play the same game again
+    {
+        {
+            ifstream in(config);
+            ofstream out("./examples/config-seed.txt");
+            out << in.rdbuf();
+        }
+        for (int i = 0; i < 100; ++ i)
+        {
+            CRandom drawn;
+            assert(drawn.getSeed() >= 1 && drawn.getSeed() <= CRandom::maxSeed);
+            saveData("./examples/config-seed.txt", "Seed", (int)drawn.getSeed());
+            CRandom replayed(CConfig("./examples/config-seed.txt").get(CONFIG_SEED));
+            assert(replayed.next() == drawn.next());
+        }
+        remove("./examples/config-seed.txt");
+    }
+
+    for (int i = 0; i < 1000; ++ i)
+    {
+        int num = random1.between(-3, 3);
+        assert(num >= -3 && num <= 3);
+    }
+
+    // The grid follows the objects when their array grows and when the removed ones leave gaps
+    {
+        struct SProbe : CObject
+        {
+            using CObject::CObject;
+            using CObject::objectCollision;
+        };
+
+        CObjectStore store;
+        store.clear(8, 8);
+        store.reserve(2, 0, 0);
+        vector<pair<int,int>> positions;
+        for (int i = 0; i < 18; ++ i)
+        {
+            positions.emplace_back(i % 6 + 1, i / 6 + 1);
+            store.add(store.bombs, positions.back(), BOMB, nullptr);
+        }
+        assert(store.bombs.capacity() > 2);
+
+        // Every third bomb explodes
+        CTileGrid tiles(8, 8);
+        CEventQueue events;
+        for (int i = 1; i < 18; i += 3)
+            for (int j = 0; j < tickRate * 2; ++ j)
+                store.bombs[i].update(events, tiles, store.grid);
+        store.removeFlagged();
+        assert(store.bombs.size() == 12);
+
+        for (int i = 0; i < 18; ++ i)
+        {
+            SProbe probe(positions[i], PLAYER1, nullptr);
+            CObject * found = probe.objectCollision(store.grid, BOMB);
+            if (i % 3 == 1)
+            {
+                assert(found == nullptr);
+                continue;
+            }
+            // Only the objects still in the array are in the grid
+            assert(found >= &store.bombs[0] && found <= &store.bombs.back());
+            assert(found->getTilePos() == positions[i]);
+        }
+
+        // The array remembers how many bombs were there at once
+        assert(store.bombs.highWaterMark() == 18);
+        store.add(store.bombs, make_pair(1, 6), BOMB, nullptr);
+        assert(store.bombs.highWaterMark() == 18);
+        store.clear(8, 8);
+        assert(store.bombs.empty() && store.bombs.highWaterMark() == 18);
+    }
+
+    // Removing the consumed events keeps the order of the rest
+    {
+        CEventQueue events;
+        for (int i = 0; i < 10; ++ i)
+            events.push(POINTS, SPoints{i});
+        int i = 0;
+        for (auto & event : events)
+            event.consumed = i ++ % 3 == 0;
+        events.removeConsumed();
+        assert(events.size() == 6);
+
+        vector<int> points;
+        for (auto & event : events)
+            points.push_back(get<SPoints>(event.data).points);
+        assert(points == vector<int>({1, 2, 4, 5, 7, 8}));
+    }
+
+    // A restored snapshot continues the game exactly the same way
+    CRandom random3(11);
+    CObjectEventManager manager(configuration, random3);
+    manager.startGame(CMap(SINGLEPLAYER, random3, configuration).getMap());
+    for (int i = 0; i < 300; ++ i)
+        manager.tick();
+
+    CSnapshot snapshot1, snapshot2, snapshot3;
+    manager.snapshot(snapshot1);
+    for (int i = 0; i < 300; ++ i)
+        manager.tick();
+    manager.snapshot(snapshot2);
+
+    manager.restore(snapshot1);
+    manager.snapshot(snapshot3);
+    assert(snapshot1.getData() == snapshot3.getData());
+    for (int i = 0; i < 300; ++ i)
+        manager.tick();
+    manager.snapshot(snapshot3);
+    assert(snapshot2.getData() == snapshot3.getData());
+
+    snapshot1.save("./examples/snapshot-test.state");
+    snapshot3.load("./examples/snapshot-test.state");
+    assert(snapshot1.getData() == snapshot3.getData());
+    remove("./examples/snapshot-test.state");
+
+    // A snapshot with an unknown event or with an event carrying the data of another one gets refused
+    {
+        // The events are saved right before the random number generator, none of them is pending between the time frames
+        CSnapshot generator;
+        generator.begin();
+        random3.save(generator);
+        size_t generatorSize = generator.getData().size() - 6;
+        const vector<uint8_t> & data = snapshot1.getData();
+        assert(vector<uint8_t>(data.end() - generatorSize - 4, data.end() - generatorSize) == vector<uint8_t>(4, 0));
+
+        auto restoreEvent = [&](const uint8_t & type, const uint8_t & index)
+        {
+            CSnapshot corrupted;
+            corrupted.begin();
+            corrupted.writeBytes(data.data() + 6, data.size() - 6 - generatorSize - 4);
+            corrupted.write<uint32_t>(1);
+            corrupted.write(type);
+            corrupted.write(index);
+            corrupted.write(false);
+            corrupted.writeBytes(data.data() + data.size() - generatorSize, generatorSize);
+            try { manager.restore(corrupted); }
+            catch (const invalid_argument & err) { return string(err.what()); }
+            return string();
+        };
+        assert(restoreEvent(DOOR_REACHED, 0).empty());
+        assert(restoreEvent(200, 0) == "The snapshot contains an unknown event");
+        assert(restoreEvent(POINTS, 0) == "The snapshot contains an event with the data of another one");
+        assert(restoreEvent(PLACE_BOMB, 4) == "The snapshot contains an event with the data of another one");
+    }
+
+    // Only the tiles without an object can be among the tiles of a snapshot
+    {
+        CTileGrid grid(2, 2);
+        CSnapshot tiles;
+        tiles.begin();
+        tiles.write(2);
+        tiles.write(2);
+        const uint8_t bytes[] = {EMPTY, WALL, BREAKABLE, ENEMY};
+        tiles.writeBytes(bytes, sizeof(bytes));
+        tiles.rewind();
+        try
+        {
+            grid.load(tiles);
+            assert(false);
+        }
+        catch (const invalid_argument & err)
+        {
+            assert(string_view(err.what()) == "The snapshot contains an unknown tile");
+        }
+    }
+
+    snapshot3.begin();
+    snapshot3.write<uint8_t>(SINGLEPLAYER);
+    try
+    {
+        manager.restore(snapshot3);
+        assert(false);
+    }
+    catch (const invalid_argument & err)
+    {
+        assert(string_view(err.what()) == "The snapshot is corrupted");
+    }
+
+    // The map dimensions come from the configuration, independently on the screen
+    {
+        {
+            ifstream in(config);
+            ofstream out("./examples/config-large.txt");
+            out << in.rdbuf();
+        }
+        saveData("./examples/config-large.txt", "Map width", 200);
+        try
+        {
+            CConfig("./examples/config-large.txt");
+            assert(false);
+        }
+        catch (const invalid_argument & err)
+        {
+            assert(string_view(err.what()) == "Invalid map width. Minimum: 5, maximum: 1001, must be odd");
+        }
+
+        saveData("./examples/config-large.txt", "Map width", 301);
+        saveData("./examples/config-large.txt", "Map height", 201);
+        CConfig large("./examples/config-large.txt");
+        remove("./examples/config-large.txt");
+
+        CRandom random6(9);
+        CObjectEventManager arena(large, random6);
+        arena.startGame(CMap(DUEL, random6, large).getMap());
+        assert(arena.getTiles().getWidth() == 301 && arena.getTiles().getHeight() == 201);
+        for (int i = 0; i < 300; ++ i)
+            arena.tick(SInputFrame{{(uint8_t)random6.between(0, 31), (uint8_t)random6.between(0, 31)}});
+
+        // The snapshot keeps the dimensions of the map
+        CSnapshot snapshot4, snapshot5;
+        arena.snapshot(snapshot4);
+        manager.restore(snapshot4);
+        manager.snapshot(snapshot5);
+        assert(snapshot4.getData() == snapshot5.getData());
+        assert(manager.saveIntoMap().first.size() == 201 && manager.saveIntoMap().first.front().size() == 301);
+    }
+
+    // The map bounds the players, not the window, the whole of a larger map can be reached
+    {
+        Map open(15, vector<ETileType>(51, EMPTY));
+        for (int y = 0; y < 15; ++ y)
+            open[y][0] = open[y][50] = WALL;
+        for (int x = 0; x < 51; ++ x)
+            open[0][x] = open[14][x] = WALL;
+        open[7][1] = PLAYER1;
+
+        // An enemy walled in a corner keeps the door away
+        open[12][48] = open[12][49] = open[13][47] = WALL;
+        open[13][48] = ENEMY;
+
+        CRandom random(3);
+        CObjectEventManager corridor(configuration, random);
+        corridor.startGame(make_pair(open, 0));
+        for (int i = 0; i < 3000; ++ i)
+            corridor.tick(SInputFrame{{INPUT_RIGHT, 0}});
+        assert(corridor.getStore().players[0].getPosition().first > screenWidth);
+        assert(corridor.getStore().players[0].getTilePos() == make_pair(49, 7));
+    }
+
+    // The chasing enemies find a player standing still in the open
+    {
+        {
+            ifstream in(config);
+            ofstream out("./examples/config-chase.txt");
+            out << in.rdbuf();
+        }
+        saveData("./examples/config-chase.txt", "Enemy chase", 1);
+        saveData("./examples/config-chase.txt", "Breakables", 0);
+        CConfig chase("./examples/config-chase.txt");
+        remove("./examples/config-chase.txt");
+
+        CRandom random7(13);
+        CObjectEventManager hunted(chase, random7);
+        hunted.startGame(CMap(SINGLEPLAYER, random7, chase).getMap());
+        for (int i = 0; i < 600; ++ i)
+            hunted.tick();
+
+        // The search of the map isn't a part of the snapshot, the game goes on the same way without it
+        CSnapshot snapshot6, snapshot7;
+        hunted.snapshot(snapshot6);
+        for (int i = 0; i < 600; ++ i)
+            hunted.tick();
+        hunted.snapshot(snapshot7);
+        hunted.restore(snapshot6);
+        for (int i = 0; i < 600; ++ i)
+            hunted.tick();
+        hunted.snapshot(snapshot6);
+        assert(snapshot6.getData() == snapshot7.getData());
+
+        for (int i = 0; i < 3000 && ! hunted.endGame; ++ i)
+            hunted.tick();
+        assert(hunted.endGame);
+    }
+
+    // The rendering is skipped only while the time frames take longer than the time they simulate
+    {
+        double time = 0;
+        CClock clock(10, 2, [&time] { return time; });
+        auto simulate = [&](const double & tickCost)
+        {
+            clock.startFrame();
+            int ticks = 0;
+            for (; clock.tick(); ++ ticks)
+                time += tickCost;
+            return ticks;
+        };
+
+        time = 30;
+        assert(simulate(1) == 3 && clock.shouldRender());
+
+        // Every time frame takes 15 ms instead of 10, the backlog grows until two frames in a row got skipped
+        time = 45;
+        assert(simulate(15) == 1 && ! clock.shouldRender());
+        assert(simulate(15) == 2 && ! clock.shouldRender());
+        assert(simulate(15) == 3 && clock.shouldRender());
+
+        // The time frames are fast again, the backlog gets worked off while rendering
+        assert(simulate(1) == 3 && clock.shouldRender());
+    }
+
+    // A finished duel stays finished, no round gets counted twice
+    {
+        CRandom random(9);
+        CObjectEventManager duel(configuration, random);
+        duel.startGame(CMap(DUEL, random, configuration).getMap());
+        for (int i = 0; i < 100000 && ! duel.endGame; ++ i)
+            duel.tick(SInputFrame{{INPUT_BOMB, INPUT_BOMB}});
+        assert(duel.endGame);
+
+        CSnapshot before, after;
+        auto roundsWon = duel.getRoundsWon();
+        duel.snapshot(before);
+        for (int i = 0; i < maxFrameSkip + 1; ++ i)
+            duel.tick(SInputFrame{{INPUT_BOMB, INPUT_BOMB}});
+        duel.snapshot(after);
+        assert(duel.getRoundsWon() == roundsWon && ! duel.needsNewMap);
+        assert(before.hash() == after.hash());
+    }
+
+    // A recorded game played back ends in the same state
+    CRandom random4(5);
+    CObjectEventManager recorded(configuration, random4);
+    recorded.startGame(CMap(DUEL, random4, configuration).getMap());
+
+    CReplay replay1;
+    SInputFrame held{};
+    replay1.begin(recorded, configuration);
+    for (int i = 0; i < 2000 && ! recorded.endGame; ++ i)
+    {
+        // Hold random keys for a while, like a player would
+        if (i % 20 == 0)
+            held = SInputFrame{{(uint8_t)random1.between(0, 31), (uint8_t)random1.between(0, 31)}};
+
+        recorded.tick(held);
+        replay1.record(held);
+    }
+    replay1.end(recorded);
+    replay1.save("./examples/replay-test.replay");
+
+    CReplay replay2;
+    CRandom random5;
+    CObjectEventManager played(configuration, random5);
+    replay2.load("./examples/replay-test.replay");
+    remove("./examples/replay-test.replay");
+    replay2.play(played, configuration);
+
+    SInputFrame input;
+    uint32_t ticks = 0;
+    while (replay2.next(input))
+    {
+        played.tick(input);
+        ++ ticks;
+    }
+    assert(ticks == replay1.getTicks() && ticks == replay2.getTicks());
+    assert(replay2.check(played));
+
+    // A different input makes the game diverge
+    replay2.play(played, configuration);
+    played.tick(SInputFrame{{INPUT_BOMB, INPUT_BOMB}});
+    while (replay2.next(input))
+        played.tick(input);
+    assert(! replay2.check(played));
+
+    // Matches running at once on a thread pool don't affect each other
+    auto playMatch = [&configuration] (const uint64_t & seed)
+    {
+        CRandom random(seed);
+        CObjectEventManager manager(configuration, random);
+        manager.startGame(CMap(DUEL, random, configuration).getMap());
+        CBot bots[2] = {CBot(PLAYER1, seed), CBot(PLAYER2, seed + 1)};
+
+        for (int i = 0; i < 600 && ! manager.endGame; ++ i)
+            manager.tick(SInputFrame{{bots[0].think(manager), bots[1].think(manager)}});
+
+        CSnapshot snapshot;
+        manager.snapshot(snapshot);
+        return snapshot.hash();
+    };
+    vector<uint64_t> hashes(8);
+    {
+        CThreadPool pool(4);
+        for (size_t i = 0; i < hashes.size(); ++ i)
+            pool.submit([&, i] { hashes[i] = playMatch(i + 1); });
+        pool.wait();
+    }
+    for (size_t i = 0; i < hashes.size(); ++ i)
+        assert(hashes[i] == playMatch(i + 1));
+
+    // The camera keeps its views inside of the map and splits the window, when the players get too far apart
+    {
+        CCamera camera(1000, 500);
+        camera.follow({{50, 50}}, 5000, 5000);
+        assert(camera.getViews().size() == 1);
+        assert(camera.getViews()[0].world.x == 0 && camera.getViews()[0].world.y == 0);
+
+        camera.follow({{4990, 2000}}, 5000, 5000);
+        assert(camera.getViews()[0].world.x == 4000 && camera.getViews()[0].world.y == 1750);
+
+        camera.follow({{1000, 1000}, {1500, 1100}}, 5000, 5000);
+        assert(camera.getViews().size() == 1 && camera.getViews()[0].world.x == 750);
+
+        camera.follow({{1000, 1000}, {4000, 1000}}, 5000, 5000);
+        assert(camera.getViews().size() == 2);
+        assert(camera.getViews()[0].screen.x == 0 && camera.getViews()[1].screen.x == 500);
+        assert(camera.getViews()[0].world.x == 750 && camera.getViews()[1].world.x == 3750);
+        assert(camera.getViews()[1].world.w == 500 && camera.getViews()[1].world.h == 500);
+
+        // Nobody to follow, the views stay
+        camera.follow({}, 5000, 5000);
+        assert(camera.getViews().size() == 2);
+
+        // A smaller map stays in the middle of the window
+        camera.follow({{100, 100}}, 600, 300);
+        assert(camera.getViews()[0].world.x == -200 && camera.getViews()[0].world.y == -100);
+    }
+
+    // The profiler records only the zones of the thread it is attached to
+    {
+        CProfiler profiler("./examples/profile-test.json", 1);
+        { CProfiler::CZone zone("not recorded"); }
+        profiler.attach();
+        profiler.beginFrame();
+        {
+            CProfiler::CZone zone("recorded");
+            thread([] { CProfiler::CZone zone("other thread"); }).join();
+        }
+        profiler.endFrame();
+        profiler.detach();
+        profiler.save();
+
+        stringstream trace;
+        trace << ifstream("./examples/profile-test.json").rdbuf();
+        remove("./examples/profile-test.json");
+        assert(trace.str().find("\"recorded\"") != string::npos && trace.str().find("\"frame\"") != string::npos);
+        assert(trace.str().find("not recorded") == string::npos && trace.str().find("other thread") == string::npos);
+
+        // The frame is recorded after the zone nested in it, still no record starts before the origin
+        assert(trace.str().find("\"ts\": -") == string::npos);
+    }
+
+    // An unwritable trace fails right when the capture of a slow frame or the trace gets written
+    {
+        CProfiler profiler("some/nonexistent/directory/trace.json", 1);
+        profiler.beginFrame();
+        this_thread::sleep_for(chrono::milliseconds(frameDelay + 5));
+        profiler.endFrame();
+        profiler.beginFrame();
+        try
+        {
+            profiler.endFrame();
+            assert(false);
+        }
+        catch (const FileException & err)
+        {
+            assert(string_view(err.what()) == "Failed to open the file");
+        }
+        try
+        {
+            profiler.save();
+            assert(false);
+        }
+        catch (const FileException & err)
+        {
+            assert(string_view(err.what()) == "Failed to open the file");
+        }
+    }
+
+    // The types of the events are gathered until they are taken, each type once
+    {
+        CConfig configuration;
+        CRandom random(5);
+        CObjectEventManager manager(configuration, random);
+        manager.startGame(CMap(DUEL, random, configuration).getMap());
+        manager.tick(SInputFrame{{INPUT_BOMB, INPUT_BOMB}});
+        assert(manager.takeFiredEvents() == 1u << PLACE_BOMB);
+        assert(manager.takeFiredEvents() == 0);
+
+        // Standing on their bombs, both players get blown up
+        uint32_t fired = 0;
+        for (int i = 0; i < 600 && ! (fired & (1u << PLAYER_DEAD)); ++ i)
+        {
+            manager.tick();
+            fired |= manager.takeFiredEvents();
+        }
+        assert((fired & (1u << PLACE_EXPLOSION)) && (fired & (1u << PLAYER_DEAD)));
+    }
+
+    // The queue between two threads keeps the order and refuses items when full
+    {
+        CSpscQueue<int, 64> queue;
+        for (int i = 0; i < 64; ++ i)
+            assert(queue.push(i));
+        assert(! queue.push(64));
+        for (int i = 0, item; i < 64; ++ i, queue.pop())
+            assert(queue.front(item) && item == i);
+
+        int item = 0;
+        assert(! queue.front(item));
+        thread producer([&queue]
+        {
+            for (int i = 0; i < 100000; ++ i)
+                while (! queue.push(i))
+                    this_thread::yield();
+        });
+        for (int i = 0; i < 100000; ++ i, queue.pop())
+        {
+            while (! queue.front(item))
+                this_thread::yield();
+            assert(item == i);
+        }
+        producer.join();
+    }
+
+    // The input reaches the time frame in which it happened, a quick tap is not lost
+    {
+        CInput input;
+        SDL_Event event{};
+        auto key = [&](Uint32 type, Uint32 timestamp, SDL_Scancode scancode)
+        {
+            event.key.type = type;
+            event.key.timestamp = timestamp;
+            event.key.repeat = 0;
+            event.key.keysym.scancode = scancode;
+            input.record(&event);
+        };
+
+        key(SDL_KEYDOWN, 10, SDL_SCANCODE_SPACE);
+        key(SDL_KEYUP, 12, SDL_SCANCODE_SPACE);
+        key(SDL_KEYDOWN, 14, SDL_SCANCODE_UP);
+        key(SDL_KEYDOWN, 50, SDL_SCANCODE_W);
+        assert(input.poll(20) == (SInputFrame{{INPUT_BOMB, INPUT_UP}}));
+        assert(input.poll(40) == (SInputFrame{{0, INPUT_UP}}));
+        assert(input.poll(60) == (SInputFrame{{INPUT_UP, INPUT_UP}}));
+
+        // A repeated key doesn't count as another press
+        key(SDL_KEYUP, 70, SDL_SCANCODE_W);
+        event.key.repeat = 1;
+        event.key.type = SDL_KEYDOWN;
+        input.record(&event);
+        assert(input.poll(80) == (SInputFrame{{0, INPUT_UP}}));
+    }
+
+    // The asset pack keeps the pixels and the glyphs, a missing or damaged pack gets refused
+    {
+        SDL_Surface * image = SDL_CreateRGBSurfaceWithFormat(0, 3, 2, 32, SDL_PIXELFORMAT_RGBA32);
+        for (int i = 0; i < 3 * 2 * 4; ++ i)
+            ((uint8_t *)image->pixels)[i] = i;
+        CAssetPack::write("./examples/assets-test.pack", {{ASSET_SPRITE, BOMB, image, {}},
+                                                          {ASSET_TEXT, HIGH_SCORE, image, {{0.5, 0, 0.25, 1}}}},
+                          CAssetPack::fingerprint({config}));
+        {
+            CAssetPack pack("./examples/assets-test.pack");
+            assert(pack.getSources() == CAssetPack::fingerprint({config}));
+            SDL_Surface * read = pack.image(ASSET_TEXT, HIGH_SCORE);
+            assert(read->w == 3 && read->h == 2 && memcmp(read->pixels, image->pixels, 3 * 2 * 4) == 0);
+            assert(pack.glyphs(ASSET_TEXT, HIGH_SCORE).size() == 1 && pack.glyphs(ASSET_TEXT, HIGH_SCORE)[0].x == 0.5);
+            assert(pack.glyphs(ASSET_SPRITE, BOMB).empty());
+            SDL_FreeSurface(read);
+
+            try { pack.image(ASSET_UI, UI_EXIT); assert(false); }
+            catch (const FileException & err) {}
+        }
+        SDL_FreeSurface(image);
+
+        // The fingerprint changes with the source files
+        assert(CAssetPack::fingerprint({config}) != CAssetPack::fingerprint({config, "./examples/map4.txt"}));
+        assert(CAssetPack::fingerprint({config}) != CAssetPack::fingerprint({"some/nonexistent/file"}));
+        {
+            ofstream("./examples/assets-test.pack") << "SOURCE";
+            uint64_t before = CAssetPack::fingerprint({"./examples/assets-test.pack"});
+            ofstream("./examples/assets-test.pack", ios::app) << "CHANGED";
+            assert(CAssetPack::fingerprint({"./examples/assets-test.pack"}) != before);
+        }
+
+        ofstream("./examples/assets-test.pack", ios::binary | ios::in) << "JUNK";
+        try { CAssetPack pack("./examples/assets-test.pack"); assert(false); }
+        catch (const FileException & err) {}
+        remove("./examples/assets-test.pack");
+
+        try { CAssetPack pack("./examples/assets-test.pack"); assert(false); }
+        catch (const FileException & err) {}
+    }
+
     cout << "\033[1;32mTESTING SUCCESSFUL\033[0m" << endl;
     return EXIT_SUCCESS;
 }
\ No newline at end of file